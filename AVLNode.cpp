@@ -8,93 +8,190 @@
  */
 
 #include "AVLNode.h"
+#include "GradingScale.h"
+#include "RecordPager.h"
 #include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+
+// FNV-1a hash of text, seeded with seed
+uint64_t hashText(uint64_t seed, std::string_view text) {
+  uint64_t hash = 14695981039346656037ull ^ seed;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// splitmix64 finalizer, so that sums of hashes stay evenly spread
+uint64_t mixHash(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+} // namespace
 
 // Constructor
-AVLNode::AVLNode(int id, const std::string &n, const std::string &c, float g)
-    : student_ID(id), name(n), GPA(0.0), height(1), left(nullptr),
-      right(nullptr) {
-  courses.push_back(CourseRecord(c, g));
+AVLNode::AVLNode(int id, std::string_view n, std::string_view c, float g)
+    : student_ID(id), height(1), size(1), refCount(1), left(nullptr),
+      right(nullptr), GPA(0.0), pageLength(0), record(new StudentRecord(n)),
+      pager(nullptr), pageOffset(0) {
+  record->courses.add(c, g);
+  calculateGPA();
+  calculateHash();
+}
+
+AVLNode::AVLNode(int id, std::string &&n, std::string &&c, float g)
+    : student_ID(id), height(1), size(1), refCount(1), left(nullptr),
+      right(nullptr), GPA(0.0), pageLength(0),
+      record(new StudentRecord(std::move(n))), pager(nullptr),
+      pageOffset(0) {
+  record->courses.add(std::move(c), g);
   calculateGPA();
+  calculateHash();
+}
+
+AVLNode::AVLNode(const AVLNode &other)
+    : student_ID(other.student_ID), height(other.height), size(other.size),
+      refCount(1), left(other.left), right(other.right), GPA(other.GPA),
+      pageLength(other.pageLength), record(nullptr), pager(nullptr),
+      pageOffset(other.pageOffset), recordHash(other.recordHash),
+      hash(other.hash) {
+  if (other.record != nullptr) {
+    record = new StudentRecord(other.record->name);
+    record->courses = other.record->courses;
+  }
+  if (other.pager != nullptr) {
+    other.pager->attach(this);
+  }
+}
+
+AVLNode::~AVLNode() {
+  if (pager != nullptr) {
+    pager->detach(this);
+  }
+  delete record;
+}
+
+const StudentRecord &AVLNode::pageIn() const { return pager->pageIn(this); }
+
+StudentRecord *AVLNode::writablePayload() {
+  payload();
+  if (record != nullptr) {
+    pageLength = 0; // The page file copy (if any) is out of date
+  }
+  return record;
 }
 
-// Helper function to convert numeric grade to GPA using American letter grade
-// system
-float gradeToGPA(float grade) {
-  if (grade >= 90.0)
-    return 4.0; // A
-  else if (grade >= 80.0)
-    return 3.0; // B
-  else if (grade >= 70.0)
-    return 2.0; // C
-  else if (grade >= 60.0)
-    return 1.0; // D
-  else
-    return 0.0; // F
+// Recompute the GPA and the memory charged for the record after a change
+void AVLNode::payloadChanged() {
+  calculateGPA();
+  calculateHash();
+  if (pager != nullptr) {
+    pager->resized(record);
+  }
 }
 
-// Calculate GPA from all courses (average of letter grade GPAs using American
-// grading system)
+// Calculate GPA from all courses (average of the grade points each grade
+// earns under the current grading policy, see GradingScale.h)
 void AVLNode::calculateGPA() {
+  const CourseList &courses = payload().courses;
+  if (record == nullptr) {
+    return; // Could not be paged in; keep the GPA it had
+  }
   if (courses.empty()) {
     GPA = 0.0;
     return;
   }
 
+  const GradingPolicy &policy = gradingPolicy();
   float totalGradePoints = 0.0;
   for (const auto &course : courses) {
-    // Convert grade (0-100) to GPA using letter grade system
-    float courseGPA = gradeToGPA(course.grade);
-    totalGradePoints += courseGPA;
+    totalGradePoints += policy.points(course.courseName.view(), course.grade);
   }
 
   GPA = totalGradePoints / courses.size();
 }
 
-// Add a new course
-void AVLNode::addCourse(const std::string &courseName, float grade) {
-  courses.push_back(CourseRecord(courseName, grade));
-  calculateGPA();
+// The record hash is a sum over the name and each course, so it does not
+// depend on the order of the courses. Each part includes the student ID,
+// and a course part its grade's bits.
+void AVLNode::calculateHash() {
+  const StudentRecord &data = payload();
+  uint64_t id = static_cast<uint32_t>(student_ID);
+  recordHash = mixHash(hashText(id, data.name.view()));
+  for (const auto &course : data.courses) {
+    uint32_t bits;
+    std::memcpy(&bits, &course.grade, sizeof(bits));
+    uint64_t tag = static_cast<uint64_t>(bits) << 32 | 1;
+    recordHash += mixHash(hashText(id, course.courseName.view()) ^ tag);
+  }
+  hash = recordHash + (left != nullptr ? left->hash : 0) +
+         (right != nullptr ? right->hash : 0);
+}
+
+// Add a new course (returns false if the student already has it)
+bool AVLNode::addCourse(std::string_view courseName, float grade) {
+  StudentRecord *data = writablePayload();
+  if (data == nullptr || !data->courses.add(courseName, grade)) {
+    return false;
+  }
+  payloadChanged();
+  return true;
+}
+
+bool AVLNode::addCourse(std::string &&courseName, float grade) {
+  StudentRecord *data = writablePayload();
+  if (data == nullptr || !data->courses.add(std::move(courseName), grade)) {
+    return false;
+  }
+  payloadChanged();
+  return true;
 }
 
 // Update an existing course grade
-bool AVLNode::updateCourse(const std::string &courseName, float newGrade) {
-  for (auto &course : courses) {
-    if (course.courseName == courseName) {
-      course.grade = newGrade;
-      calculateGPA();
-      return true;
-    }
+bool AVLNode::updateCourse(std::string_view courseName, float newGrade) {
+  StudentRecord *data = writablePayload();
+  if (data == nullptr || !data->courses.update(courseName, newGrade)) {
+    return false;
   }
-  return false;
+  payloadChanged();
+  return true;
 }
 
 // Delete a course
-bool AVLNode::deleteCourse(const std::string &courseName) {
-  for (auto it = courses.begin(); it != courses.end(); ++it) {
-    if (it->courseName == courseName) {
-      courses.erase(it);
-      calculateGPA();
-      return true;
-    }
+bool AVLNode::deleteCourse(std::string_view courseName) {
+  StudentRecord *data = writablePayload();
+  if (data == nullptr || !data->courses.erase(courseName)) {
+    return false;
   }
-  return false;
+  payloadChanged();
+  return true;
 }
 
 // Check if student has a specific course
-bool AVLNode::hasCourse(const std::string &courseName) const {
-  for (const auto &course : courses) {
-    if (course.courseName == courseName) {
-      return true;
-    }
-  }
-  return false;
+bool AVLNode::hasCourse(std::string_view courseName) const {
+  return payload().courses.contains(courseName);
+}
+
+// Look up a course record by name (nullptr if not taken)
+const CourseRecord *AVLNode::findCourse(std::string_view courseName) const {
+  const CourseList &courses = payload().courses;
+  int pos = courses.find(courseName);
+  return pos < 0 ? nullptr : &courses[pos];
 }
 
 // Getters
 int AVLNode::getStudentID() const { return student_ID; }
 
-std::string AVLNode::getName() const { return name; }
+std::string_view AVLNode::getName() const { return payload().name.view(); }
 
 float AVLNode::getGPA() const { return GPA; }
 
@@ -104,9 +201,9 @@ AVLNode *AVLNode::getLeft() const { return left; }
 
 AVLNode *AVLNode::getRight() const { return right; }
 
-const std::vector<CourseRecord> &AVLNode::getCourses() const { return courses; }
+const CourseList &AVLNode::getCourses() const { return payload().courses; }
 
-int AVLNode::getCourseCount() const { return courses.size(); }
+int AVLNode::getCourseCount() const { return payload().courses.size(); }
 
 // Setters
 void AVLNode::setHeight(int h) { height = h; }
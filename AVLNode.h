@@ -6,36 +6,79 @@
  * Defines the AVLNode class representing a single node in the AVL Tree.
  * Each node stores student information: ID, name, and multiple courses with
  * grades. GPA is automatically calculated from all courses.
+ *
+ * The name and courses live in a separate StudentRecord, so the fields a
+ * search reads share one cache line. In a tiered tree the record of a cold
+ * student may be paged out to disk (see RecordPager.h); the getters page it
+ * back in.
+ *
+ * Each node also keeps a hash of its record and of its whole subtree (the
+ * sum of its students' record hashes), so two trees can be compared by
+ * descending only where the hashes differ (see AVLTree::diff).
  */
 
 #ifndef AVLNODE_H
 #define AVLNODE_H
 
+#include "CourseList.h"
+#include <cstdint>
 #include <string>
-#include <utility> // for pair
-#include <vector>
+#include <string_view>
+#include <utility>
+
+class AVLNode;
+class RecordPager;
+
+// The payload of a node
+struct StudentRecord {
+  ShortString name; // Inline storage, no heap allocation for typical names
+  CourseList courses; // Multiple courses and grades, indexed by name
 
-// Structure to hold course information
-struct CourseRecord {
-  std::string courseName;
-  float grade;
+  // Least-recently-used list of a RecordPager (unused in untiered trees)
+  const AVLNode *owner;
+  StudentRecord *newer;
+  StudentRecord *older;
+  size_t bytes; // Memory charged to the pager's budget
 
-  CourseRecord(const std::string &name, float g) : courseName(name), grade(g) {}
+  template <typename Name>
+  explicit StudentRecord(Name &&n)
+      : name(std::forward<Name>(n)), owner(nullptr), newer(nullptr),
+        older(nullptr), bytes(0) {}
 };
 
 class AVLNode {
 private:
+  // Fields read while descending the tree come first, so a search touches
+  // one cache line per level
   int student_ID;
-  std::string name;
-  std::vector<CourseRecord> courses; // Multiple courses and grades
-  float GPA;
   int height;
+  int size;     // Number of students in this subtree (for rank queries)
+  int refCount; // Parents and tree versions sharing this node (see AVLTree)
   AVLNode *left;
   AVLNode *right;
+  float GPA;
+  mutable uint32_t pageLength;   // Record bytes in the page file, 0 if none
+  mutable StudentRecord *record; // nullptr while paged out
+  RecordPager *pager;            // nullptr unless the tree is tiered
+  mutable uint64_t pageOffset;
+  uint64_t recordHash; // Hash of the ID, name and courses with grades
+  uint64_t hash;       // Sum of recordHash over the subtree
 
   // Helper function to calculate GPA from all courses
   void calculateGPA();
 
+  // Recompute recordHash, and hash from it and the children's hashes
+  void calculateHash();
+
+  // The record, paged in if necessary; the writable one also marks the copy
+  // in the page file as stale, and is nullptr if it could not be paged in
+  const StudentRecord &payload() const {
+    return record != nullptr ? *record : pageIn();
+  }
+  const StudentRecord &pageIn() const;
+  StudentRecord *writablePayload();
+  void payloadChanged();
+
 public:
   /**
    * Constructor - Creates a new AVL node with student data
@@ -44,31 +87,49 @@ public:
    * @param c Course name
    * @param g Grade
    */
-  AVLNode(int id, const std::string &n, const std::string &c, float g);
+  AVLNode(int id, std::string_view n, std::string_view c, float g);
+
+  /**
+   * Constructor - Same as above, but moves the name and course strings in
+   */
+  AVLNode(int id, std::string &&n, std::string &&c, float g);
+
+  /**
+   * Copy constructor - Copies the record (or, if it is paged out, shares
+   * its copy in the page file)
+   */
+  AVLNode(const AVLNode &other);
+  AVLNode &operator=(const AVLNode &) = delete;
+
+  ~AVLNode();
 
-  // Getters
+  // Getters (views stay valid until the node is modified or deleted, and in
+  // a tiered tree until the next operation on the tree)
   int getStudentID() const;
-  std::string getName() const;
+  std::string_view getName() const;
   float getGPA() const;
   int getHeight() const;
   AVLNode *getLeft() const;
   AVLNode *getRight() const;
-  const std::vector<CourseRecord> &getCourses() const;
+  const CourseList &getCourses() const;
   int getCourseCount() const;
 
-  // Course management
-  void addCourse(const std::string &courseName, float grade);
-  bool updateCourse(const std::string &courseName, float newGrade);
-  bool deleteCourse(const std::string &courseName);
-  bool hasCourse(const std::string &courseName) const;
+  // Course management (expected O(1) per call, see CourseList)
+  bool addCourse(std::string_view courseName, float grade);
+  bool addCourse(std::string &&courseName, float grade);
+  bool updateCourse(std::string_view courseName, float newGrade);
+  bool deleteCourse(std::string_view courseName);
+  bool hasCourse(std::string_view courseName) const;
+  const CourseRecord *findCourse(std::string_view courseName) const;
 
   // Setters
   void setHeight(int h);
   void setLeft(AVLNode *l);
   void setRight(AVLNode *r);
 
-  // Friend class to allow AVLTree to access private members
+  // Friend classes to allow AVLTree and RecordPager to access private members
   friend class AVLTree;
+  friend class RecordPager;
 };
 
 #endif // AVLNODE_H
@@ -8,29 +8,120 @@
  */
 
 #include "AVLTree.h"
+#include "ExternalSort.h"
+#include "GradeArchive.h"
+#include "FrozenLayout.h"
+#include "RecordPager.h"
+#include "GradingScale.h"
+#include "Metrics.h"
+#include "OffsetIndex.h"
+#include "Prefetch.h"
+#include "WorkloadTrace.h"
 #include <algorithm>
+#include <climits>
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <utility>
+
+// CSV file being loaded on demand (see loadLazily)
+struct AVLTree::LazyFile {
+  std::string filename;
+  std::ifstream file;
+  OffsetIndex offsets;
+  std::vector<bool> loaded; // Which blocks are in the tree
+  size_t blocksLeft;
+};
+
+namespace {
+
+// Parse "StudentID,Name,Course,Grade,GPA" (GPA is recomputed, not read)
+bool parseCSVRow(const std::string &line, int &student_ID, std::string &name,
+                 std::string &course, float &grade) {
+  std::stringstream ss(line);
+  std::string token;
+  try {
+    // Parse student_ID
+    std::getline(ss, token, ',');
+    student_ID = std::stoi(token);
+
+    // Parse name
+    std::getline(ss, name, ',');
+
+    // Parse course
+    std::getline(ss, course, ',');
+
+    // Parse grade
+    std::getline(ss, token, ',');
+    grade = std::stof(token);
+  } catch (const std::exception &e) {
+    return false;
+  }
+  return true;
+}
+
+// With more than one stale student per this many students, recomputing
+// every hash is cheaper than walking each stale student's path
+const size_t FULL_REHASH_RATIO = 16;
+
+} // namespace
 
 // Constructor
-AVLTree::AVLTree() : root(nullptr) {}
+AVLTree::AVLTree()
+    : root(nullptr), recorder(nullptr), indexed(true),
+      shareGroups(1, std::make_shared<char>()), pager(nullptr),
+      rehashAll(false) {}
+
+// Copy constructor - shares the other tree's nodes (but not its index)
+AVLTree::AVLTree(const AVLTree &other)
+    : root(nullptr), recorder(nullptr), indexed(false),
+      shareGroups(other.shareGroups), pager(nullptr), rehashAll(false) {
+  other.loadRemaining(); // The copy does not load from the file
+  other.settleHashes();
+  root = other.root;
+  retainTree(root);
+  usePager(other.pager);
+}
 
-// Destructor
-AVLTree::~AVLTree() { destroyTree(root); }
+AVLTree &AVLTree::operator=(const AVLTree &other) {
+  other.loadRemaining();
+  other.settleHashes();
+  lazy.reset(); // This tree's contents are replaced
+  thaw();
+  staleHashes.clear();
+  rehashAll = false;
+  retainTree(other.root); // Retain first in case other is this tree
+  releaseTree(root);
+  root = other.root;
+  shareGroups = other.shareGroups;
+  index.clear(); // The other tree's nodes are not indexed
+  names.clear();
+  courses.clear();
+  indexed = false;
+  usePager(other.pager);
+  return *this;
+}
 
-// Helper function to destroy the tree recursively
-void AVLTree::destroyTree(AVLNode *node) {
-  if (node != nullptr) {
-    destroyTree(node->left);
-    destroyTree(node->right);
-    delete node;
+// Destructor
+AVLTree::~AVLTree() {
+  releaseTree(root);
+  for (const auto &version : versions) {
+    releaseTree(version.second);
   }
+  usePager(nullptr);
 }
 
 // Check if tree is empty
-bool AVLTree::isEmpty() const { return root == nullptr; }
+bool AVLTree::isEmpty() const {
+  loadRemaining();
+  return root == nullptr;
+}
+
+void AVLTree::setRecorder(WorkloadRecorder *workloadRecorder) {
+  recorder = workloadRecorder;
+}
 
 // ==================== HELPER FUNCTIONS ====================
 
@@ -41,6 +132,27 @@ int AVLTree::getHeight(AVLNode *node) {
   return node->height;
 }
 
+int AVLTree::getSize(AVLNode *node) {
+  if (node == nullptr) {
+    return 0;
+  }
+  return node->size;
+}
+
+uint64_t AVLTree::getHash(const AVLNode *node) {
+  if (node == nullptr) {
+    return 0;
+  }
+  return node->hash;
+}
+
+// Recompute a node's height, subtree size and subtree hash from its children
+void AVLTree::updateNode(AVLNode *node) {
+  node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
+  node->size = 1 + getSize(node->left) + getSize(node->right);
+  node->hash = node->recordHash + getHash(node->left) + getHash(node->right);
+}
+
 int AVLTree::getBalance(AVLNode *node) {
   if (node == nullptr) {
     return 0;
@@ -48,75 +160,312 @@ int AVLTree::getBalance(AVLNode *node) {
   return getHeight(node->left) - getHeight(node->right);
 }
 
+// Rotations own (path-copy) both nodes they relink; the caller stores the
+// returned subtree root in place of the node it passed in
 AVLNode *AVLTree::rotateLeft(AVLNode *x) {
-  AVLNode *y = x->right;
+  PS5_COUNT_ROTATION();
+  x = ownNode(x);
+  AVLNode *y = ownNode(x->right);
   AVLNode *T2 = y->left;
 
   y->left = x;
   x->right = T2;
 
-  x->height = 1 + std::max(getHeight(x->left), getHeight(x->right));
-  y->height = 1 + std::max(getHeight(y->left), getHeight(y->right));
+  updateNode(x);
+  updateNode(y);
 
   return y;
 }
 
 AVLNode *AVLTree::rotateRight(AVLNode *y) {
-  AVLNode *x = y->left;
+  PS5_COUNT_ROTATION();
+  y = ownNode(y);
+  AVLNode *x = ownNode(y->left);
   AVLNode *T2 = x->right;
 
   x->right = y;
   y->left = T2;
 
-  y->height = 1 + std::max(getHeight(y->left), getHeight(y->right));
-  x->height = 1 + std::max(getHeight(x->left), getHeight(x->right));
+  updateNode(y);
+  updateNode(x);
 
   return x;
 }
 
-AVLNode *AVLTree::findMinNode(AVLNode *node) {
-  AVLNode *current = node;
-  while (current->left != nullptr) {
-    current = current->left;
+// Restore the AVL property at node after a child subtree changed height
+AVLNode *AVLTree::rebalance(AVLNode *node) {
+  updateNode(node);
+  int balance = getBalance(node);
+
+  // Left-Left Case
+  if (balance > 1 && getBalance(node->left) >= 0) {
+    return rotateRight(node);
+  }
+
+  // Left-Right Case
+  if (balance > 1 && getBalance(node->left) < 0) {
+    node->left = rotateLeft(node->left);
+    return rotateRight(node);
+  }
+
+  // Right-Right Case
+  if (balance < -1 && getBalance(node->right) <= 0) {
+    return rotateLeft(node);
+  }
+
+  // Right-Left Case
+  if (balance < -1 && getBalance(node->right) > 0) {
+    node->right = rotateRight(node->right);
+    return rotateLeft(node);
+  }
+
+  return node;
+}
+
+// ==================== PERSISTENCE HELPERS ====================
+
+// Add a reference to a (shared) subtree
+void AVLTree::retainTree(AVLNode *node) {
+  if (node != nullptr) {
+    node->refCount++;
+  }
+}
+
+// Drop a reference to a subtree, deleting nodes nobody else shares
+void AVLTree::releaseTree(AVLNode *node) {
+  if (node != nullptr && --node->refCount == 0) {
+    releaseTree(node->left);
+    releaseTree(node->right);
+    delete node;
+  }
+}
+
+// Return a node that may be modified in place. The caller must own the parent
+// (or the root slot) and store the result in place of node. A node shared
+// with another version is copied; the copy shares its children.
+AVLNode *AVLTree::ownNode(AVLNode *node) {
+  if (node == nullptr || node->refCount == 1) {
+    return node;
+  }
+
+  AVLNode *copy = new AVLNode(*node);
+  copy->refCount = 1;
+  retainTree(copy->left);
+  retainTree(copy->right);
+  node->refCount--; // The parent now points at the copy instead
+  if (indexed) {
+    index.set(copy->student_ID, copy);
+  }
+  return copy;
+}
+
+// Path-copy from the root down to a student so its record can be modified
+AVLNode *AVLTree::ownPath(int student_ID) {
+  AVLNode **slot = &root;
+  while (*slot != nullptr) {
+    *slot = ownNode(*slot);
+    AVLNode *node = *slot;
+    if (node->student_ID == student_ID) {
+      return node;
+    }
+    slot = student_ID < node->student_ID ? &node->left : &node->right;
+  }
+  return nullptr;
+}
+
+// Point lookup without recording or timing (used inside other operations)
+// The hash index beats the frozen layout for point lookups; copies have none
+AVLNode *AVLTree::findNode(int student_ID) {
+  AVLNode *node;
+  if (indexed) {
+    node = index.find(student_ID);
+  } else {
+    node = frozen != nullptr ? frozen->find(student_ID)
+                             : searchHelper(root, student_ID);
+  }
+  if (pager != nullptr && node != nullptr && node->pager != nullptr) {
+    node->pager->touch(node);
+  }
+  return node;
+}
+
+// True if a saved version or another tree may share this tree's nodes
+bool AVLTree::sharesNodes() const {
+  return !versions.empty() || sharesWithOtherTrees();
+}
+
+bool AVLTree::sharesWithOtherTrees() const {
+  for (const auto &group : shareGroups) {
+    if (group.use_count() > 1) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Record that this tree now shares nodes with other and its relatives
+void AVLTree::joinShareGroups(const AVLTree &other) {
+  for (const auto &group : other.shareGroups) {
+    if (std::find(shareGroups.begin(), shareGroups.end(), group) ==
+        shareGroups.end()) {
+      shareGroups.push_back(group);
+    }
+  }
+}
+
+// Node of a student that may be modified in place. If no other tree or
+// version can share this tree's nodes, every node is already owned and the
+// index finds it in O(1); otherwise path-copy down to it.
+AVLNode *AVLTree::writableNode(int student_ID) {
+  if (indexed && !sharesNodes()) {
+    return index.find(student_ID);
+  }
+  return ownPath(student_ID);
+}
+
+// ==================== SUBTREE HASHES ====================
+
+// A student's record hash changed but the subtree hashes above it were not
+// recomputed (an edit that did not rebuild the path to the student)
+void AVLTree::markHashStale(int student_ID) {
+  if (rehashAll) {
+    return;
   }
-  return current;
+  if (staleHashes.size() >= static_cast<size_t>(getSize(root)) /
+                                FULL_REHASH_RATIO) {
+    staleHashes.clear();
+    rehashAll = true;
+    return;
+  }
+  staleHashes.push_back(student_ID);
+}
+
+// Bring every subtree hash up to date. The out-of-date nodes are the
+// ancestors of the stale students, i.e. their search paths (rotations since
+// the edit have recomputed the nodes they moved). Shared nodes are never
+// out of date, and neither is anything below them.
+void AVLTree::settleHashes() const {
+  if (rehashAll) {
+    rehashSubtree(root);
+    rehashAll = false;
+    return;
+  }
+  std::vector<AVLNode *> path;
+  for (int student_ID : staleHashes) {
+    path.clear();
+    AVLNode *node = root;
+    while (node != nullptr && node->refCount == 1) {
+      path.push_back(node);
+      if (node->student_ID == student_ID) {
+        break;
+      }
+      node = student_ID < node->student_ID ? node->left : node->right;
+    }
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+      (*it)->hash = (*it)->recordHash + getHash((*it)->left) +
+                    getHash((*it)->right);
+    }
+  }
+  staleHashes.clear();
+}
+
+void AVLTree::rehashSubtree(AVLNode *node) {
+  if (node == nullptr || node->refCount > 1) {
+    return;
+  }
+  rehashSubtree(node->left);
+  rehashSubtree(node->right);
+  node->hash = node->recordHash + getHash(node->left) + getHash(node->right);
 }
 
 // ==================== INSERT OPERATION ====================
 
-void AVLTree::insert(int student_ID, const std::string &name,
-                     const std::string &course, float grade) {
-  root = insertHelper(root, student_ID, name, course, grade);
+void AVLTree::adoptNode(AVLNode *created) {
+  if (pager != nullptr) {
+    pager->attach(created);
+  }
+  if (indexed) {
+    index.set(created->student_ID, created);
+    names.add(created->getName(), created->student_ID);
+    indexCourses(created);
+  }
+}
+
+// Add/remove every course of a student to/from the course index
+void AVLTree::indexCourses(const AVLNode *student) {
+  for (const auto &course : student->getCourses()) {
+    courses.add(course.courseName.view(), student->student_ID);
+  }
+}
+
+void AVLTree::unindexCourses(const AVLNode *student) {
+  for (const auto &course : student->getCourses()) {
+    courses.remove(course.courseName.view(), student->student_ID);
+  }
+}
+
+// Add a course to a student already in the tree (node must be owned)
+// (course is only moved from when it is actually added)
+template <typename Course>
+void AVLTree::addCourseToExisting(AVLNode *node, Course &&course,
+                                  float grade) {
+  if (!node->addCourse(std::forward<Course>(course), grade)) {
+    reportCourseAdded(node, course, false);
+  } else {
+    std::string_view added = node->getCourses().back().courseName.view();
+    if (indexed) {
+      courses.add(added, node->student_ID);
+    }
+    markHashStale(node->student_ID);
+    reportCourseAdded(node, added, true);
+  }
+}
+
+void AVLTree::reportCourseAdded(const AVLNode *student,
+                                std::string_view courseName, bool added) {
+  if (!added) {
+    std::cout << "Note: Student ID " << student->student_ID
+              << " already has course '" << courseName
+              << "'. Use Update to modify the grade." << std::endl;
+  } else {
+    std::cout << "Course '" << courseName << "' added to student ID "
+              << student->student_ID << ". GPA updated to " << std::fixed
+              << std::setprecision(2) << student->getGPA() << std::endl;
+  }
 }
 
-AVLNode *AVLTree::insertHelper(AVLNode *node, int student_ID,
-                               const std::string &name,
-                               const std::string &course, float grade) {
+// created, if given, receives the new student's node
+template <typename Name, typename Course>
+AVLNode *AVLTree::insertHelper(AVLNode *node, int student_ID, Name &&name,
+                               Course &&course, float grade,
+                               AVLNode **created) {
   // 1. Perform standard BST insertion
   if (node == nullptr) {
-    return new AVLNode(student_ID, name, course, grade);
+    AVLNode *student = new AVLNode(student_ID, std::forward<Name>(name),
+                                   std::forward<Course>(course), grade);
+    adoptNode(student);
+    if (created != nullptr) {
+      *created = student;
+    }
+    return student;
   }
+  node = ownNode(node); // Path-copy if shared with a saved version
 
   if (student_ID < node->student_ID) {
-    node->left = insertHelper(node->left, student_ID, name, course, grade);
+    node->left = insertHelper(node->left, student_ID, std::forward<Name>(name),
+                              std::forward<Course>(course), grade, created);
   } else if (student_ID > node->student_ID) {
-    node->right = insertHelper(node->right, student_ID, name, course, grade);
+    node->right =
+        insertHelper(node->right, student_ID, std::forward<Name>(name),
+                     std::forward<Course>(course), grade, created);
   } else {
     // Student ID already exists - add course to existing student
-    if (node->hasCourse(course)) {
-      std::cout << "Note: Student ID " << student_ID << " already has course '"
-                << course << "'. Use Update to modify the grade." << std::endl;
-    } else {
-      node->addCourse(course, grade);
-      std::cout << "Course '" << course << "' added to student ID "
-                << student_ID << ". GPA updated to " << std::fixed
-                << std::setprecision(2) << node->getGPA() << std::endl;
-    }
+    addCourseToExisting(node, std::forward<Course>(course), grade);
     return node;
   }
 
-  // 2. Update height of current node
-  node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
+  // 2. Update height (and subtree size) of current node
+  updateNode(node);
 
   // 3. Get balance factor
   int balance = getBalance(node);
@@ -148,63 +497,165 @@ AVLNode *AVLTree::insertHelper(AVLNode *node, int student_ID,
   return node;
 }
 
-// ==================== SEARCH OPERATION ====================
-
-AVLNode *AVLTree::search(int student_ID) {
-  return searchHelper(root, student_ID);
+void AVLTree::insert(int student_ID, const std::string &name,
+                     const std::string &course, float grade) {
+  PS5_TIME_OP(INSERT);
+  thaw();
+  trimRecords();
+  faultIn(student_ID);
+  if (recorder != nullptr) {
+    recorder->insert(student_ID, name, course, grade);
+  }
+  if (findNode(student_ID) != nullptr) {
+    addCourseToExisting(writableNode(student_ID), course, grade);
+    return;
+  }
+  root = insertHelper(root, student_ID, name, course, grade);
 }
 
-AVLNode *AVLTree::searchHelper(AVLNode *node, int student_ID) {
-  if (node == nullptr || node->student_ID == student_ID) {
-    return node;
+void AVLTree::insert(int student_ID, std::string &&name, std::string &&course,
+                     float grade) {
+  PS5_TIME_OP(INSERT);
+  thaw();
+  trimRecords();
+  faultIn(student_ID);
+  if (recorder != nullptr) {
+    recorder->insert(student_ID, name, course, grade);
   }
-
-  if (student_ID < node->student_ID) {
-    return searchHelper(node->left, student_ID);
+  if (findNode(student_ID) != nullptr) {
+    addCourseToExisting(writableNode(student_ID), std::move(course), grade);
+    return;
   }
-
-  return searchHelper(node->right, student_ID);
+  root = insertHelper(root, student_ID, std::move(name), std::move(course),
+                      grade);
 }
 
-// ==================== UPDATE OPERATIONS ====================
+// ==================== STUDENT HANDLES ====================
 
-bool AVLTree::updateCourse(int student_ID, const std::string &courseName,
-                           float newGrade) {
-  AVLNode *student = search(student_ID);
+StudentHandle::StudentHandle()
+    : tree(nullptr), studentID(0), node(nullptr), created(false),
+      owned(false) {}
+
+StudentHandle::StudentHandle(AVLTree *owner, int student_ID,
+                             AVLNode *student, bool isNew)
+    : tree(owner), studentID(student_ID), node(student), created(isNew),
+      owned(isNew) {} // insert path-copies down to a new student
+
+StudentHandle AVLTree::lookup(int student_ID) {
+  return StudentHandle(this, student_ID, search(student_ID), false);
+}
 
+StudentHandle AVLTree::findOrCreate(int student_ID, std::string &&name,
+                                    std::string &&course, float grade) {
+  trimRecords();
+  faultIn(student_ID);
+  AVLNode *student = findNode(student_ID);
   if (student != nullptr) {
-    return student->updateCourse(courseName, newGrade);
+    if (recorder != nullptr) {
+      recorder->search(student_ID);
+    }
+    return StudentHandle(this, student_ID, student, false);
   }
 
-  return false;
+  PS5_TIME_OP(INSERT); // Only creating a student counts as an insert
+  thaw();
+  if (recorder != nullptr) {
+    recorder->insert(student_ID, name, course, grade);
+  }
+  root = insertHelper(root, student_ID, std::move(name), std::move(course),
+                      grade, &student);
+  return StudentHandle(this, student_ID, student, true);
 }
 
-bool AVLTree::addCourseToStudent(int student_ID, const std::string &courseName,
-                                 float grade) {
-  AVLNode *student = search(student_ID);
-
-  if (student == nullptr) {
-    return false; // Student not found
+StudentHandle AVLTree::upsert(int student_ID, std::string &&name,
+                              std::string &&course, float grade) {
+  StudentHandle student =
+      findOrCreate(student_ID, std::move(name), std::move(course), grade);
+  if (!student.wasCreated()) {
+    student.setCourse(course, grade); // Not moved from (see findOrCreate)
   }
+  return student;
+}
+
+// Handle for an ID-based edit (the edit itself is recorded)
+StudentHandle AVLTree::findHandle(int student_ID) {
+  faultIn(student_ID);
+  return StudentHandle(this, student_ID, findNode(student_ID), false);
+}
 
-  if (student->hasCourse(courseName)) {
-    return false; // Course already exists
+// The handle's node, ready to be modified in place. Without the in-place
+// case of writableNode(int), the first edit path-copies down to it.
+AVLNode *AVLTree::writableNode(StudentHandle &student) {
+  if (!student.owned && !(indexed && !sharesNodes())) {
+    student.node = ownPath(student.studentID);
+    student.owned = true;
   }
+  return student.node;
+}
 
-  student->addCourse(courseName, grade);
+bool StudentHandle::addCourse(std::string_view courseName, float grade) {
+  if (tree == nullptr) {
+    return false;
+  }
+  tree->thaw();
+  tree->trimRecords();
+  if (tree->recorder != nullptr) {
+    tree->recorder->addCourse(studentID, courseName, grade);
+  }
+  if (node == nullptr || node->hasCourse(courseName)) {
+    return false; // Student not found or course exists
+  }
+  if (!tree->writableNode(*this)->addCourse(courseName, grade)) {
+    return false;
+  }
+  if (tree->indexed) {
+    tree->courses.add(courseName, studentID);
+  }
+  tree->markHashStale(studentID);
   return true;
 }
 
-// ==================== DELETE OPERATIONS ====================
+bool StudentHandle::updateCourse(std::string_view courseName,
+                                 float newGrade) {
+  if (tree == nullptr) {
+    return false;
+  }
+  tree->thaw();
+  tree->trimRecords();
+  if (tree->recorder != nullptr) {
+    tree->recorder->updateCourse(studentID, courseName, newGrade);
+  }
+  if (node == nullptr || !node->hasCourse(courseName)) {
+    return false;
+  }
+  if (!tree->writableNode(*this)->updateCourse(courseName, newGrade)) {
+    return false;
+  }
+  tree->markHashStale(studentID);
+  return true;
+}
 
-bool AVLTree::deleteCourse(int student_ID, const std::string &courseName) {
-  AVLNode *student = search(student_ID);
+bool StudentHandle::setCourse(std::string_view courseName, float grade) {
+  if (node != nullptr && node->hasCourse(courseName)) {
+    return updateCourse(courseName, grade);
+  }
+  return addCourse(courseName, grade);
+}
 
-  if (student == nullptr) {
+bool StudentHandle::deleteCourse(std::string_view courseName) {
+  if (tree == nullptr) {
+    return false;
+  }
+  tree->thaw();
+  tree->trimRecords();
+  if (tree->recorder != nullptr) {
+    tree->recorder->deleteCourse(studentID, courseName);
+  }
+  if (node == nullptr) {
     return false;
   }
 
-  if (student->getCourseCount() == 1) {
+  if (node->getCourseCount() == 1) {
     std::cout << "Warning: This is the student's only course. Deleting it will "
                  "remove the student entirely."
               << std::endl;
@@ -214,80 +665,400 @@ bool AVLTree::deleteCourse(int student_ID, const std::string &courseName) {
     return false;
   }
 
-  return student->deleteCourse(courseName);
+  if (!node->hasCourse(courseName)) {
+    return false;
+  }
+
+  if (!tree->writableNode(*this)->deleteCourse(courseName)) {
+    return false;
+  }
+  if (tree->indexed) {
+    tree->courses.remove(courseName, studentID);
+  }
+  tree->markHashStale(studentID);
+  return true;
 }
 
-void AVLTree::deleteStudent(int student_ID) {
-  root = deleteHelper(root, student_ID);
+// ==================== SEARCH OPERATION ====================
+
+AVLNode *AVLTree::search(int student_ID) {
+  PS5_TIME_OP(SEARCH);
+  trimRecords();
+  faultIn(student_ID);
+  if (recorder != nullptr) {
+    recorder->search(student_ID);
+  }
+  return findNode(student_ID);
 }
 
-AVLNode *AVLTree::deleteHelper(AVLNode *node, int student_ID) {
-  if (node == nullptr) {
-    return node;
+void AVLTree::searchMany(const std::vector<int> &studentIDs,
+                         std::vector<AVLNode *> &nodes) {
+  PS5_TIME_OP(SEARCH_MANY);
+  trimRecords();
+  for (size_t i = 0; lazy != nullptr && i < studentIDs.size(); ++i) {
+    faultIn(studentIDs[i]);
+  }
+  if (recorder != nullptr) {
+    for (int id : studentIDs) {
+      recorder->search(id);
+    }
   }
 
-  if (student_ID < node->student_ID) {
-    node->left = deleteHelper(node->left, student_ID);
-  } else if (student_ID > node->student_ID) {
-    node->right = deleteHelper(node->right, student_ID);
+  size_t count = studentIDs.size();
+  nodes.assign(count, nullptr);
+  if (indexed) {
+    index.findMany(studentIDs.data(), count, nodes.data());
+  } else if (frozen != nullptr) {
+    for (size_t i = 0; i < count; ++i) {
+      nodes[i] = frozen->find(studentIDs[i]);
+    }
   } else {
-    // Node to be deleted found
-
-    if (node->left == nullptr) {
-      AVLNode *temp = node->right;
-      delete node;
-      return temp;
-    } else if (node->right == nullptr) {
-      AVLNode *temp = node->left;
-      delete node;
-      return temp;
+    descendMany(studentIDs, nodes);
+  }
+  for (size_t i = 0; pager != nullptr && i < count; ++i) {
+    if (nodes[i] != nullptr && nodes[i]->pager != nullptr) {
+      nodes[i]->pager->touch(nodes[i]);
     }
+  }
+}
 
-    // Node with 2 children
-    AVLNode *temp = findMinNode(node->right);
+// Group prefetching: SEARCH_LANES descents advance in lockstep
+void AVLTree::descendMany(const std::vector<int> &studentIDs,
+                          std::vector<AVLNode *> &nodes) {
+  size_t count = studentIDs.size();
+  const size_t SEARCH_LANES = 16;
+  AVLNode *cursor[SEARCH_LANES];
+  for (size_t first = 0; first < count; first += SEARCH_LANES) {
+    size_t lanes = std::min(SEARCH_LANES, count - first);
+    for (size_t lane = 0; lane < lanes; ++lane) {
+      cursor[lane] = root;
+    }
 
-    // Copy data
-    node->student_ID = temp->student_ID;
-    node->name = temp->name;
-    node->courses = temp->courses;
-    node->GPA = temp->GPA;
+    bool pending = root != nullptr;
+    while (pending) {
+      pending = false;
+      for (size_t lane = 0; lane < lanes; ++lane) {
+        AVLNode *node = cursor[lane];
+        if (node == nullptr) {
+          continue;
+        }
+        int id = studentIDs[first + lane];
+        if (node->student_ID == id) {
+          nodes[first + lane] = node;
+          cursor[lane] = nullptr;
+          continue;
+        }
+        node = id < node->student_ID ? node->left : node->right;
+        cursor[lane] = node;
+        if (node != nullptr) {
+          prefetchRead(node);
+          pending = true;
+        }
+      }
+    }
+  }
+}
 
-    node->right = deleteHelper(node->right, temp->student_ID);
+const AVLNode *AVLTree::find(int student_ID) const {
+  // A lazily loaded tree is modified here; snapshots never load lazily
+  const_cast<AVLTree *>(this)->faultIn(student_ID);
+  if (indexed) {
+    return index.find(student_ID);
+  }
+  if (frozen != nullptr) {
+    return frozen->find(student_ID);
+  }
+  const AVLNode *node = root;
+  while (node != nullptr && node->student_ID != student_ID) {
+    node = student_ID < node->student_ID ? node->left : node->right;
   }
+  return node;
+}
 
-  if (node == nullptr) {
+AVLNode *AVLTree::searchHelper(AVLNode *node, int student_ID) {
+  if (node == nullptr || node->student_ID == student_ID) {
     return node;
   }
 
-  // Update height and balance
-  node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
-  int balance = getBalance(node);
+  if (student_ID < node->student_ID) {
+    return searchHelper(node->left, student_ID);
+  }
 
-  // Left-Left Case
-  if (balance > 1 && getBalance(node->left) >= 0) {
-    return rotateRight(node);
+  return searchHelper(node->right, student_ID);
+}
+
+// ==================== NAME SEARCH ====================
+
+// The live name index, or one built in scratch for trees without an index
+const NameIndex &AVLTree::nameIndex(NameIndex &scratch) const {
+  loadRemaining();
+  if (indexed) {
+    return names;
   }
+  forEachStudent([&](const AVLNode &student) {
+    scratch.add(student.getName(), student.getStudentID());
+  });
+  return scratch;
+}
 
-  // Left-Right Case
-  if (balance > 1 && getBalance(node->left) < 0) {
-    node->left = rotateLeft(node->left);
-    return rotateRight(node);
+std::vector<StudentMatch> AVLTree::searchByNamePrefix(std::string_view prefix,
+                                                      size_t limit) {
+  trimRecords();
+  NameIndex scratch;
+  std::vector<StudentMatch> result;
+  for (int id : nameIndex(scratch).prefix(prefix, limit)) {
+    result.push_back({findNode(id), 0});
   }
+  return result;
+}
 
-  // Right-Right Case
-  if (balance < -1 && getBalance(node->right) <= 0) {
-    return rotateLeft(node);
+std::vector<StudentMatch> AVLTree::searchByNameFuzzy(std::string_view name,
+                                                     int maxDistance,
+                                                     size_t limit) {
+  trimRecords();
+  NameIndex scratch;
+  std::vector<StudentMatch> result;
+  for (const NameMatch &match :
+       nameIndex(scratch).fuzzy(name, maxDistance, limit)) {
+    result.push_back({findNode(match.studentID), match.distance});
   }
+  return result;
+}
 
-  // Right-Left Case
-  if (balance < -1 && getBalance(node->right) > 0) {
-    node->right = rotateRight(node->right);
-    return rotateLeft(node);
+// ==================== COURSE COHORTS ====================
+
+std::vector<int> AVLTree::cohort(const CohortQuery &query) {
+  trimRecords();
+  loadRemaining();
+  CourseIndex scratch;
+  CourseIndex *source = &courses;
+  if (!indexed) {
+    forEachStudent([&](const AVLNode &student) {
+      for (const auto &course : student.getCourses()) {
+        scratch.add(course.courseName.view(), student.getStudentID());
+      }
+    });
+    source = &scratch;
   }
 
-  return node;
+  std::vector<int> everyone; // Only needed to negate
+  if (query.allOf.empty() && query.anyOf.empty()) {
+    everyone.reserve(size());
+    forEachStudent([&](const AVLNode &student) {
+      everyone.push_back(student.getStudentID());
+    });
+  }
+  return source->query(query, everyone);
+}
+
+// ==================== RANK OPERATIONS ====================
+
+int AVLTree::rank(int student_ID) const {
+  loadRemaining();
+  if (recorder != nullptr) {
+    recorder->rank(student_ID);
+  }
+  if (frozen != nullptr) {
+    size_t position = frozen->lowerBound(student_ID);
+    bool found = position < frozen->size() &&
+                 frozen->student(position)->student_ID == student_ID;
+    return found ? static_cast<int>(position) : -1;
+  }
+  int smaller = 0;
+  AVLNode *node = root;
+  while (node != nullptr) {
+    if (student_ID < node->student_ID) {
+      node = node->left;
+    } else {
+      int leftSize = node->left != nullptr ? node->left->size : 0;
+      if (student_ID == node->student_ID) {
+        return smaller + leftSize;
+      }
+      smaller += leftSize + 1;
+      node = node->right;
+    }
+  }
+  return -1;
+}
+
+int AVLTree::size() const {
+  loadRemaining();
+  return root != nullptr ? root->size : 0;
+}
+
+// ==================== UPDATE OPERATIONS ====================
+
+bool AVLTree::updateCourse(int student_ID, std::string_view courseName,
+                           float newGrade) {
+  PS5_TIME_OP(UPDATE_COURSE);
+  return findHandle(student_ID).updateCourse(courseName, newGrade);
+}
+
+bool AVLTree::addCourseToStudent(int student_ID, std::string_view courseName,
+                                 float grade) {
+  return findHandle(student_ID).addCourse(courseName, grade);
+}
+
+// ==================== DELETE OPERATIONS ====================
+
+bool AVLTree::deleteCourse(int student_ID, std::string_view courseName) {
+  return findHandle(student_ID).deleteCourse(courseName);
+}
+
+void AVLTree::deleteStudent(int student_ID) {
+  PS5_TIME_OP(DELETE_STUDENT);
+  thaw();
+  trimRecords();
+  faultIn(student_ID);
+  if (recorder != nullptr) {
+    recorder->deleteStudent(student_ID);
+  }
+  // Avoid path-copying shared nodes when there is nothing to delete
+  AVLNode *student = findNode(student_ID);
+  if (student == nullptr) {
+    return;
+  }
+  if (indexed) {
+    names.remove(student->getName(), student_ID);
+    unindexCourses(student);
+  }
+  root = deleteHelper(root, student_ID);
+  if (indexed) {
+    index.erase(student_ID); // After deleteHelper, which may re-point it
+  }
 }
 
+AVLNode *AVLTree::deleteHelper(AVLNode *node, int student_ID) {
+  if (node == nullptr) {
+    return node;
+  }
+  node = ownNode(node); // Path-copy if shared with a saved version
+
+  if (student_ID < node->student_ID) {
+    node->left = deleteHelper(node->left, student_ID);
+  } else if (student_ID > node->student_ID) {
+    node->right = deleteHelper(node->right, student_ID);
+  } else {
+    // Node to be deleted found
+
+    if (node->left == nullptr) {
+      AVLNode *temp = node->right;
+      delete node;
+      return temp;
+    } else if (node->right == nullptr) {
+      AVLNode *temp = node->left;
+      delete node;
+      return temp;
+    }
+
+    // Node with 2 children: the in-order successor takes its place
+    AVLNode *successor = nullptr;
+    AVLNode *rightRest = detachMin(node->right, successor);
+    successor->left = node->left;
+    successor->right = rightRest;
+    delete node; // Owned, and its children now belong to successor
+    node = successor;
+  }
+
+  // Update height and balance
+  return rebalance(node);
+}
+
+// Unlink the minimum node of a subtree (path-copying shared nodes)
+// Returns the rebalanced subtree; minNode receives the owned minimum node
+AVLNode *AVLTree::detachMin(AVLNode *node, AVLNode *&minNode) {
+  node = ownNode(node);
+  if (node->left == nullptr) {
+    minNode = node;
+    AVLNode *rest = node->right;
+    node->right = nullptr;
+    return rest;
+  }
+  node->left = detachMin(node->left, minNode);
+  return rebalance(node);
+}
+
+// ==================== TRAVERSAL ====================
+
+void AVLTree::forEachStudent(
+    const std::function<void(const AVLNode &)> &visit) const {
+  loadRemaining();
+  forEachHelper(root, visit);
+}
+
+void AVLTree::forEachHelper(const AVLNode *node,
+                            const std::function<void(const AVLNode &)> &visit) {
+  if (node != nullptr) {
+    forEachHelper(node->left, visit);
+    bool resident = node->record != nullptr;
+    visit(*node);
+    endScan(node, resident);
+    forEachHelper(node->right, visit);
+  }
+}
+
+void AVLTree::forEachInRange(
+    int lowID, int highID,
+    const std::function<void(const AVLNode &)> &visit) const {
+  loadRemaining();
+  if (frozen != nullptr) {
+    for (size_t i = frozen->lowerBound(lowID);
+         i < frozen->size() && frozen->student(i)->student_ID <= highID; ++i) {
+      const AVLNode *node = frozen->student(i);
+      bool resident = node->record != nullptr;
+      visit(*node);
+      endScan(node, resident);
+    }
+    return;
+  }
+  rangeHelper(root, lowID, highID, visit);
+}
+
+// In-order walk of the subtrees that can hold IDs in [lowID, highID]
+void AVLTree::rangeHelper(const AVLNode *node, int lowID, int highID,
+                          const std::function<void(const AVLNode &)> &visit) {
+  if (node == nullptr) {
+    return;
+  }
+  if (lowID < node->student_ID) {
+    rangeHelper(node->left, lowID, highID, visit);
+  }
+  if (lowID <= node->student_ID && node->student_ID <= highID) {
+    bool resident = node->record != nullptr;
+    visit(*node);
+    endScan(node, resident);
+  }
+  if (node->student_ID < highID) {
+    rangeHelper(node->right, lowID, highID, visit);
+  }
+}
+
+// ==================== FROZEN LAYOUT ====================
+
+void AVLTree::freeze() {
+  loadRemaining(); // Edits from lazy loading would invalidate the layout
+  std::vector<AVLNode *> students;
+  students.reserve(size());
+  // Iterative in-order walk
+  std::vector<AVLNode *> stack;
+  for (AVLNode *node = root; node != nullptr || !stack.empty();) {
+    if (node != nullptr) {
+      stack.push_back(node);
+      node = node->left;
+    } else {
+      node = stack.back();
+      stack.pop_back();
+      students.push_back(node);
+      node = node->right;
+    }
+  }
+  frozen = std::make_unique<FrozenLayout>(std::move(students));
+}
+
+void AVLTree::thaw() { frozen.reset(); }
+
+bool AVLTree::isFrozen() const { return frozen != nullptr; }
+
 // ==================== DISPLAY OPERATION ====================
 
 void AVLTree::display() {
@@ -300,6 +1071,7 @@ void AVLTree::display() {
   std::cout << "STUDENT GRADE RECORDS (Sorted by Student ID)" << std::endl;
   std::cout << std::string(90, '=') << std::endl;
 
+  trimRecords();
   inorderTraversal(root);
 
   std::cout << std::string(90, '=') << std::endl;
@@ -308,10 +1080,12 @@ void AVLTree::display() {
 void AVLTree::inorderTraversal(AVLNode *node) {
   if (node != nullptr) {
     inorderTraversal(node->left);
+    bool resident = node->record != nullptr;
 
     // Display student header
     std::cout << "\nStudent ID: " << node->student_ID
-              << " | Name: " << node->name << " | Overall GPA: " << std::fixed
+              << " | Name: " << node->getName() << " | Overall GPA: "
+              << std::fixed
               << std::setprecision(2) << node->GPA
               << " | Courses: " << node->getCourseCount() << std::endl;
     std::cout << std::string(90, '-') << std::endl;
@@ -321,24 +1095,17 @@ void AVLTree::inorderTraversal(AVLNode *node) {
               << "Grade" << std::setw(15) << "Letter Grade" << std::endl;
     std::cout << "  " << std::string(70, '-') << std::endl;
 
+    const GradingPolicy &policy = gradingPolicy();
     for (const auto &course : node->getCourses()) {
-      std::string letterGrade;
-      if (course.grade >= 90)
-        letterGrade = "A";
-      else if (course.grade >= 80)
-        letterGrade = "B";
-      else if (course.grade >= 70)
-        letterGrade = "C";
-      else if (course.grade >= 60)
-        letterGrade = "D";
-      else
-        letterGrade = "F";
+      const std::string &letterGrade =
+          policy.letter(course.courseName.view(), course.grade);
 
       std::cout << "  " << std::left << std::setw(40) << course.courseName
                 << std::setw(15) << std::fixed << std::setprecision(2)
                 << course.grade << std::setw(15) << letterGrade << std::endl;
     }
 
+    endScan(node, resident);
     inorderTraversal(node->right);
   }
 }
@@ -346,7 +1113,16 @@ void AVLTree::inorderTraversal(AVLNode *node) {
 // ==================== SAVE TO FILE OPERATION ====================
 
 void AVLTree::saveToFile(const std::string &filename) {
-  std::ofstream file(filename);
+  PS5_TIME_OP(SAVE_FILE);
+  PS5_TRACE_SPAN("saveToFile");
+  loadRemaining(); // Before the file may be replaced
+  trimRecords();
+  // Write to a temporary file, then atomically replace the old file
+  // (".gca" files use the compact archive format, see GradeArchive.h)
+  bool archive = isArchiveFilename(filename);
+  std::string tempName = filename + ".tmp";
+  std::ofstream file(tempName, archive ? std::ios::out | std::ios::binary
+                                       : std::ios::out);
 
   if (!file.is_open()) {
     std::cout << "Error: Could not open file '" << filename << "' for writing."
@@ -354,43 +1130,95 @@ void AVLTree::saveToFile(const std::string &filename) {
     return;
   }
 
-  // Write CSV header
-  file << "StudentID,Name,Course,Grade,GPA" << std::endl;
+  uint64_t started = PS5_CLOCK();
+  bool written = archive ? writeArchive(*this, file) : writeCSV(file);
+  file.close();
+  uint64_t wrote = PS5_CLOCK();
+  PS5_PHASE(SAVE_WRITE, wrote - started, 1);
 
-  saveToFileHelper(root, file);
+  bool renamed = written && !file.fail() &&
+                 std::rename(tempName.c_str(), filename.c_str()) == 0;
+  PS5_PHASE(SAVE_RENAME, PS5_CLOCK() - wrote, 1);
+
+  if (!renamed) {
+    std::remove(tempName.c_str());
+    std::cout << "Error: Could not write file '" << filename << "'."
+              << std::endl;
+    return;
+  }
 
-  file.close();
   std::cout << "Data successfully saved to '" << filename << "'." << std::endl;
 }
 
-void AVLTree::saveToFileHelper(AVLNode *node, std::ofstream &file) {
+bool AVLTree::writeCSV(std::ostream &out,
+                       std::atomic<int> *studentsWritten) const {
+  loadRemaining();
+  uint64_t failures = pager != nullptr ? pager->pageInFailures() : 0;
+  // Write CSV header
+  out << "StudentID,Name,Course,Grade,GPA\n";
+  out << std::fixed << std::setprecision(2);
+
+  saveToFileHelper(root, out, studentsWritten);
+  out.flush();
+  // A record that could not be paged in was written without its courses
+  return out.good() &&
+         (pager == nullptr || pager->pageInFailures() == failures);
+}
+
+void AVLTree::saveToFileHelper(const AVLNode *node, std::ostream &out,
+                               std::atomic<int> *studentsWritten) const {
   if (node != nullptr) {
-    saveToFileHelper(node->left, file);
+    saveToFileHelper(node->left, out, studentsWritten);
+    bool resident = node->record != nullptr;
 
     // Write one line per course
+    std::string_view name = node->getName();
     for (const auto &course : node->getCourses()) {
-      file << node->student_ID << "," << node->name << "," << course.courseName
-           << "," << std::fixed << std::setprecision(2) << course.grade << ","
-           << std::fixed << std::setprecision(2) << node->GPA << std::endl;
+      out << node->student_ID << "," << name << "," << course.courseName
+          << "," << course.grade << "," << node->GPA << '\n';
+    }
+    endScan(node, resident);
+    if (studentsWritten != nullptr) {
+      studentsWritten->fetch_add(1, std::memory_order_relaxed);
     }
 
-    saveToFileHelper(node->right, file);
+    saveToFileHelper(node->right, out, studentsWritten);
   }
 }
 
 // ==================== LOAD FROM FILE OPERATION ====================
 
-void AVLTree::loadFromFile(const std::string &filename) {
-  std::ifstream file(filename);
+bool AVLTree::loadFromFile(const std::string &filename) {
+  PS5_TIME_OP(LOAD_FILE);
+  PS5_TRACE_SPAN("loadFromFile");
+  thaw();
+  loadRemaining(); // Rows already in the tree take precedence
+  bool archive = isArchiveFilename(filename);
+  std::ifstream file(filename, archive ? std::ios::in | std::ios::binary
+                                       : std::ios::in);
 
   if (!file.is_open()) {
     std::cout << "Error: Could not open file '" << filename << "' for reading."
               << std::endl;
-    return;
+    return false;
+  }
+
+  if (archive) {
+    std::string error;
+    int loaded = loadArchive(*this, file, error);
+    if (loaded < 0) {
+      std::cout << "Error: Archive '" << filename << "' is damaged (" << error
+                << "). Records before the damage were loaded." << std::endl;
+      return false;
+    }
+    std::cout << "Successfully loaded " << loaded << " course records from '"
+              << filename << "'." << std::endl;
+    return true;
   }
 
   std::string line;
   int count = 0;
+  uint64_t parseNanos = 0, insertNanos = 0;
 
   // Skip header line
   std::getline(file, line);
@@ -401,42 +1229,801 @@ void AVLTree::loadFromFile(const std::string &filename) {
       continue;
     }
 
-    std::stringstream ss(line);
-    std::string token;
-
+    uint64_t started = PS5_CLOCK();
     int student_ID;
     std::string name, course;
     float grade;
+    if (!parseCSVRow(line, student_ID, name, course, grade)) {
+      std::cout << "Error parsing line: " << line << std::endl;
+      continue;
+    }
+
+    // Insert - will automatically add course if student exists
+    uint64_t parsed = PS5_CLOCK();
+    insert(student_ID, std::move(name), std::move(course), grade);
+    insertNanos += PS5_CLOCK() - parsed;
+    parseNanos += parsed - started;
+    count++;
+  }
 
-    try {
-      // Parse student_ID
-      std::getline(ss, token, ',');
-      student_ID = std::stoi(token);
+  file.close();
+  PS5_PHASE(LOAD_PARSE, parseNanos, count);
+  PS5_PHASE(LOAD_INSERT, insertNanos, count);
+  std::cout << "Successfully loaded " << count << " course records from '"
+            << filename << "'." << std::endl;
+  return true;
+}
 
-      // Parse name
-      std::getline(ss, name, ',');
+// ==================== LAZY LOADING ====================
 
-      // Parse course
-      std::getline(ss, course, ',');
+void AVLTree::loadLazily(const std::string &filename) {
+  PS5_TRACE_SPAN("loadLazily");
+  thaw();
+  if (isArchiveFilename(filename) || !isEmpty()) {
+    loadFromFile(filename); // Rows must not be merged in out of order
+    return;
+  }
 
-      // Parse grade
-      std::getline(ss, token, ',');
-      grade = std::stof(token);
+  auto source = std::make_unique<LazyFile>();
+  source->filename = filename;
+  source->file.open(filename, std::ios::in | std::ios::binary);
+  if (!source->file.is_open()) {
+    std::cout << "Error: Could not open file '" << filename << "' for reading."
+              << std::endl;
+    return;
+  }
+
+  bool rebuilt;
+  if (!source->offsets.open(filename, rebuilt)) {
+    std::cout << "Note: '" << filename
+              << "' is not sorted by student ID; loading all of it."
+              << std::endl;
+    loadFromFile(filename);
+    return;
+  }
+
+  size_t blocks = source->offsets.blockCount();
+  std::cout << "Indexed " << source->offsets.studentCount()
+            << " students in '" << filename << "' (" << blocks << " blocks"
+            << (rebuilt ? ", index rebuilt" : "")
+            << "); records are loaded when first used." << std::endl;
+  if (blocks > 0) {
+    source->loaded.assign(blocks, false);
+    source->blocksLeft = blocks;
+    lazy = std::move(source);
+  }
+}
+
+// Load the block of the lazily loaded file that may hold a student
+void AVLTree::faultIn(int student_ID) {
+  if (lazy == nullptr || !lazy->offsets.mayContain(student_ID)) {
+    return;
+  }
+  int block = lazy->offsets.findBlock(student_ID);
+  if (block >= 0 && !lazy->loaded[block]) {
+    loadBlock(block);
+  }
+}
 
-      // Parse GPA (skip it, we recalculate automatically with American system)
-      std::getline(ss, token, ',');
+// Load every block not loaded yet, for operations over all students.
+// Logically const: the file already defines what the tree contains.
+void AVLTree::loadRemaining() const {
+  AVLTree *self = const_cast<AVLTree *>(this);
+  for (size_t block = 0;
+       self->lazy != nullptr && block < self->lazy->loaded.size(); ++block) {
+    if (!self->lazy->loaded[block]) {
+      self->loadBlock(block);
+    }
+  }
+}
 
-      // Insert - will automatically add course if student exists
-      insert(student_ID, name, course, grade);
-      count++;
+void AVLTree::loadBlock(size_t block) {
+  PS5_TRACE_SPAN("loadBlock");
+  LazyFile &source = *lazy;
+  const OffsetIndex::Block &range = source.offsets.block(block);
+  source.loaded[block] = true;
+
+  std::string text(range.length, '\0');
+  source.file.clear();
+  source.file.seekg(range.offset);
+  source.file.read(&text[0], text.size());
+  if (!source.file) {
+    std::cout << "Error: Could not read '" << source.filename
+              << "'; some records were not loaded." << std::endl;
+    text.resize(source.file.gcount());
+  }
 
-    } catch (const std::exception &e) {
+  uint64_t parseNanos = 0, insertNanos = 0;
+  int count = 0;
+  std::istringstream rows(text);
+  std::string line;
+  while (std::getline(rows, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    uint64_t started = PS5_CLOCK();
+    int student_ID;
+    std::string name, course;
+    float grade;
+    if (!parseCSVRow(line, student_ID, name, course, grade)) {
       std::cout << "Error parsing line: " << line << std::endl;
       continue;
     }
+    uint64_t parsed = PS5_CLOCK();
+    loadRow(student_ID, std::move(name), std::move(course), grade);
+    insertNanos += PS5_CLOCK() - parsed;
+    parseNanos += parsed - started;
+    count++;
+  }
+  PS5_PHASE(LOAD_PARSE, parseNanos, count);
+  PS5_PHASE(LOAD_INSERT, insertNanos, count);
+
+  if (--source.blocksLeft == 0) {
+    lazy.reset(); // Everything is loaded; close the file
+  }
+}
+
+// Add a row of the lazily loaded file. Unlike insert() this prints nothing,
+// since it happens inside another operation.
+void AVLTree::loadRow(int student_ID, std::string &&name,
+                      std::string &&course, float grade) {
+  if (recorder != nullptr) {
+    recorder->insert(student_ID, name, course, grade);
+  }
+  if (findNode(student_ID) != nullptr) {
+    AVLNode *student = writableNode(student_ID);
+    if (student->addCourse(std::move(course), grade)) {
+      if (indexed) {
+        courses.add(student->getCourses().back().courseName.view(),
+                    student_ID);
+      }
+      markHashStale(student_ID);
+    }
+    return;
   }
+  root = insertHelper(root, student_ID, std::move(name), std::move(course),
+                      grade);
+}
 
+// ==================== EXTERNAL LOADING ====================
+
+void AVLTree::loadExternal(const std::string &filename,
+                           size_t memoryLimitBytes) {
+  PS5_TRACE_SPAN("loadExternal");
+  thaw();
+  if (isArchiveFilename(filename) || !isEmpty()) {
+    loadFromFile(filename); // Rows already in the tree take precedence
+    return;
+  }
+  PS5_TIME_OP(LOAD_FILE);
+
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    std::cout << "Error: Could not open file '" << filename << "' for reading."
+              << std::endl;
+    return;
+  }
+
+  // 1. Parse the rows into sorted runs
+  ExternalSorter sorter(filename + ".run", memoryLimitBytes);
+  std::string line;
+  int count = 0;
+  bool ok = true; // False once a run could not be written
+  uint64_t parseNanos = 0, sortNanos = 0;
+  std::getline(file, line); // Skip header line
+  while (ok && std::getline(file, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    uint64_t started = PS5_CLOCK();
+    int student_ID;
+    std::string name, course;
+    float grade;
+    if (!parseCSVRow(line, student_ID, name, course, grade)) {
+      std::cout << "Error parsing line: " << line << std::endl;
+      continue;
+    }
+    if (recorder != nullptr) {
+      recorder->insert(student_ID, name, course, grade);
+    }
+    uint64_t parsed = PS5_CLOCK();
+    ok = sorter.add(student_ID, std::move(name), std::move(course), grade);
+    sortNanos += PS5_CLOCK() - parsed;
+    parseNanos += parsed - started;
+    count++;
+  }
   file.close();
+
+  // 2. Merge the runs
+  uint64_t merging = PS5_CLOCK();
+  ok = ok && sorter.sort();
+  sortNanos += PS5_CLOCK() - merging;
+  PS5_PHASE(LOAD_PARSE, parseNanos, count);
+  PS5_PHASE(LOAD_SORT, sortNanos, count);
+  if (!ok) {
+    std::cout << "Error: Could not write or merge the sorted runs of '"
+              << filename << "' (" << sorter.error()
+              << "). Nothing was loaded." << std::endl;
+    return;
+  }
+
+  // 3. Build the tree from the students in ID order; rows of one student
+  // are in file order, so the first row's name is kept as with insert
+  uint64_t building = PS5_CLOCK();
+  SortedSpine spine;
+  AVLNode *student = nullptr;
+  SortRow row;
+  while (sorter.next(row)) {
+    if (student != nullptr && row.studentID == student->student_ID) {
+      if (student->addCourse(std::move(row.course), row.grade) && indexed) {
+        courses.add(student->getCourses().back().courseName.view(),
+                    row.studentID);
+      }
+      continue;
+    }
+    if (student != nullptr) {
+      appendSorted(spine, student);
+      trimRecords();
+    }
+    student = new AVLNode(row.studentID, std::move(row.name),
+                          std::move(row.course), row.grade);
+    adoptNode(student);
+  }
+  if (student != nullptr) {
+    appendSorted(spine, student);
+  }
+  root = finishSorted(spine);
+  PS5_PHASE(LOAD_INSERT, PS5_CLOCK() - building, count);
+
+  if (sorter.failed()) {
+    std::cout << "Error: Could not read back the sorted rows of '" << filename
+              << "' (" << sorter.error()
+              << "). Records before the error were loaded." << std::endl;
+    return;
+  }
   std::cout << "Successfully loaded " << count << " course records from '"
-            << filename << "'." << std::endl;
+            << filename << "'";
+  if (sorter.runCount() > 0) {
+    std::cout << " (" << sorter.runCount() << " sorted runs, "
+              << sorter.mergePasses() << " merge pass"
+              << (sorter.mergePasses() == 1 ? "" : "es") << ")";
+  }
+  std::cout << "." << std::endl;
+}
+
+// Append the next student in ID order. Like a carry in binary counting,
+// trailing spine subtrees of equal height are combined under the node that
+// follows them, so each node is linked once: O(1) amortized.
+void AVLTree::appendSorted(SortedSpine &spine, AVLNode *node) {
+  AVLNode *carry = nullptr;
+  while (!spine.empty() && getHeight(spine.back().first) == getHeight(carry)) {
+    AVLNode *parent = spine.back().second;
+    parent->left = spine.back().first;
+    parent->right = carry;
+    updateNode(parent);
+    carry = parent;
+    spine.pop_back();
+  }
+  spine.emplace_back(carry, node);
+}
+
+// Join the spine's subtrees (of decreasing height) from the right
+// Time Complexity: O(log n), since the height differences add up to log n
+AVLNode *AVLTree::finishSorted(SortedSpine &spine) {
+  AVLNode *tree = nullptr;
+  while (!spine.empty()) {
+    tree = join(spine.back().first, spine.back().second, tree);
+    spine.pop_back();
+  }
+  return tree;
+}
+
+// ==================== REGRADE ====================
+
+void AVLTree::regradeAll() {
+  thaw();
+  loadRemaining();
+  trimRecords();
+  root = regradeHelper(root);
+}
+
+AVLNode *AVLTree::regradeHelper(AVLNode *node) {
+  if (node == nullptr) {
+    return nullptr;
+  }
+  node = ownNode(node);
+  node->left = regradeHelper(node->left);
+  node->right = regradeHelper(node->right);
+  bool resident = node->record != nullptr;
+  node->calculateGPA();
+  endScan(node, resident);
+  return node;
+}
+
+// ==================== TIERED STORAGE ====================
+
+bool AVLTree::enableTiering(const std::string &pageFile, size_t budgetBytes) {
+  if (pager != nullptr) {
+    pager->setBudget(budgetBytes);
+    trimRecords();
+    return true;
+  }
+  if (sharesWithOtherTrees()) {
+    return false; // A copy may be in use on another thread
+  }
+  pager = RecordPager::create(pageFile, budgetBytes);
+  if (pager == nullptr) {
+    return false;
+  }
+  attachTree(root);
+  for (const auto &version : versions) {
+    attachTree(version.second);
+  }
+  trimRecords();
+  return true;
+}
+
+bool AVLTree::isTiered() const { return pager != nullptr; }
+
+// Page the records of a subtree through this tree's pager
+void AVLTree::attachTree(AVLNode *node) {
+  if (node == nullptr || node->pager == pager) {
+    return; // Attached earlier, together with its subtree
+  }
+  if (node->pager == nullptr) {
+    pager->attach(node);
+  }
+  attachTree(node->left);
+  attachTree(node->right);
+}
+
+// Switch to another tree's pager (or none), keeping it alive while used
+void AVLTree::usePager(RecordPager *newPager) {
+  if (newPager != nullptr) {
+    newPager->retain();
+  }
+  if (pager != nullptr) {
+    pager->release();
+  }
+  pager = newPager;
+}
+
+// Page out least recently used records; called at the start of operations
+// so views returned by the previous one stay valid until then
+void AVLTree::trimRecords() {
+  if (pager != nullptr) {
+    pager->trim();
+  }
+}
+
+// A scan pages a record it had to read back out right after using it, so
+// one pass over all students neither exceeds the budget nor evicts the
+// recently used records
+void AVLTree::endScan(const AVLNode *node, bool wasResident) {
+  if (!wasResident && node->pager != nullptr) {
+    node->pager->pageOut(node);
+  }
+}
+
+// ==================== JOIN, SPLIT AND MERGE ====================
+
+// Join two trees with every key of left < mid < every key of right
+// (mid is a detached, owned node)
+AVLNode *AVLTree::join(AVLNode *left, AVLNode *mid, AVLNode *right) {
+  if (getHeight(left) > getHeight(right) + 1) {
+    return joinRight(left, mid, right);
+  }
+  if (getHeight(right) > getHeight(left) + 1) {
+    return joinLeft(left, mid, right);
+  }
+  mid->left = left;
+  mid->right = right;
+  updateNode(mid);
+  if (indexed) {
+    index.set(mid->student_ID, mid);
+  }
+  return mid;
+}
+
+// left is the taller tree: descend its right spine to a subtree of about
+// right's height, hang (subtree, mid, right) there and rebalance upwards
+AVLNode *AVLTree::joinRight(AVLNode *left, AVLNode *mid, AVLNode *right) {
+  left = ownNode(left);
+  if (getHeight(left->right) <= getHeight(right) + 1) {
+    left->right = join(left->right, mid, right);
+  } else {
+    left->right = joinRight(left->right, mid, right);
+  }
+  return rebalance(left);
+}
+
+AVLNode *AVLTree::joinLeft(AVLNode *left, AVLNode *mid, AVLNode *right) {
+  right = ownNode(right);
+  if (getHeight(right->left) <= getHeight(left) + 1) {
+    right->left = join(left, mid, right->left);
+  } else {
+    right->left = joinLeft(left, mid, right->left);
+  }
+  return rebalance(right);
+}
+
+// Split a subtree into the students below student_ID, the student itself
+// (detached, or nullptr) and the students above it
+void AVLTree::split(AVLNode *node, int student_ID, AVLNode *&less,
+                    AVLNode *&found, AVLNode *&greater) {
+  if (node == nullptr) {
+    less = found = greater = nullptr;
+    return;
+  }
+
+  node = ownNode(node);
+  AVLNode *left = node->left;
+  AVLNode *right = node->right;
+  node->left = node->right = nullptr;
+
+  if (student_ID == node->student_ID) {
+    updateNode(node);
+    less = left;
+    found = node;
+    greater = right;
+  } else if (student_ID < node->student_ID) {
+    AVLNode *rest;
+    split(left, student_ID, less, found, rest);
+    greater = join(rest, node, right);
+  } else {
+    AVLNode *rest;
+    split(right, student_ID, rest, found, greater);
+    less = join(left, node, rest);
+  }
+}
+
+// Index every student of a subtree taken from another tree
+void AVLTree::indexSubtree(AVLNode *node) {
+  if (node != nullptr) {
+    index.set(node->student_ID, node);
+    bool resident = node->record != nullptr;
+    names.add(node->getName(), node->student_ID);
+    indexCourses(node);
+    endScan(node, resident);
+    indexSubtree(node->left);
+    indexSubtree(node->right);
+  }
+}
+
+// Both trees have this student: keep one detached node, release the other
+AVLNode *AVLTree::resolveConflict(AVLNode *mine, AVLNode *theirs,
+                                  MergePolicy policy) {
+  if (policy == KEEP_INCOMING) {
+    if (indexed && mine->getName() != theirs->getName()) {
+      names.remove(mine->getName(), mine->student_ID);
+      names.add(theirs->getName(), theirs->student_ID);
+    }
+    if (indexed) {
+      unindexCourses(mine);
+      indexCourses(theirs);
+    }
+    std::swap(mine, theirs);
+  } else if (policy == MERGE_COURSES) {
+    for (const auto &course : theirs->getCourses()) {
+      std::string_view name = course.courseName.view();
+      if (!mine->updateCourse(name, course.grade) &&
+          mine->addCourse(name, course.grade) && indexed) {
+        courses.add(name, mine->student_ID);
+      }
+    }
+  }
+  releaseTree(theirs);
+  return mine;
+}
+
+// Union of two subtrees: split theirs around my root, merge the halves
+// recursively and join them back around the root
+AVLNode *AVLTree::unionHelper(AVLNode *mine, AVLNode *theirs,
+                              MergePolicy policy) {
+  if (theirs == nullptr) {
+    return mine;
+  }
+  if (mine == nullptr) {
+    if (indexed) {
+      indexSubtree(theirs);
+    }
+    return theirs;
+  }
+
+  mine = ownNode(mine);
+  AVLNode *myLeft = mine->left;
+  AVLNode *myRight = mine->right;
+  mine->left = mine->right = nullptr;
+
+  AVLNode *theirLeft, *match, *theirRight;
+  split(theirs, mine->student_ID, theirLeft, match, theirRight);
+
+  AVLNode *left = unionHelper(myLeft, theirLeft, policy);
+  AVLNode *right = unionHelper(myRight, theirRight, policy);
+  if (match != nullptr) {
+    mine = resolveConflict(mine, match, policy);
+  }
+  return join(left, mine, right);
+}
+
+void AVLTree::merge(const AVLTree &other, MergePolicy policy) {
+  thaw();
+  trimRecords();
+  loadRemaining();
+  other.loadRemaining();
+  if (other.root == nullptr || other.root == root) {
+    return;
+  }
+  settleHashes();
+  other.settleHashes();
+  retainTree(other.root); // Consumed by unionHelper
+  joinShareGroups(other);
+  root = unionHelper(root, other.root, policy);
+}
+
+AVLTree AVLTree::splitRange(int lowID, int highID) const {
+  loadRemaining();
+  settleHashes();
+  AVLTree result;
+  result.indexed = false;
+  result.shareGroups = shareGroups; // Shares nodes with this tree
+  result.usePager(pager);
+  if (lowID > highID) {
+    return result;
+  }
+
+  retainTree(root); // Consumed by the splits
+  AVLNode *below, *low, *rest;
+  result.split(root, lowID, below, low, rest);
+  releaseTree(below);
+
+  AVLNode *inRange, *high, *above;
+  result.split(rest, highID, inRange, high, above);
+  releaseTree(above);
+
+  // The boundary students themselves are in range
+  if (low != nullptr) {
+    inRange = result.join(nullptr, low, inRange);
+  }
+  if (high != nullptr) {
+    inRange = result.join(inRange, high, nullptr);
+  }
+  result.root = inRange;
+  return result;
+}
+
+// ==================== VERSIONS (SEMESTER SNAPSHOTS) ====================
+
+void AVLTree::saveVersion(const std::string &label) {
+  loadRemaining();
+  settleHashes();
+  if (recorder != nullptr) {
+    recorder->saveVersion(label);
+  }
+  retainTree(root);
+  auto it = versions.find(label);
+  if (it != versions.end()) {
+    releaseTree(it->second);
+    it->second = root;
+  } else {
+    versions[label] = root;
+  }
+}
+
+AVLTree AVLTree::getVersion(const std::string &label) const {
+  AVLTree version;
+  version.indexed = false;
+  version.shareGroups = shareGroups; // Shares nodes with this tree
+  version.usePager(pager);
+  auto it = versions.find(label);
+  if (it != versions.end()) {
+    version.root = it->second;
+    retainTree(version.root);
+  }
+  return version;
+}
+
+bool AVLTree::hasVersion(const std::string &label) const {
+  return versions.count(label) > 0;
+}
+
+bool AVLTree::dropVersion(const std::string &label) {
+  if (recorder != nullptr) {
+    recorder->dropVersion(label);
+  }
+  auto it = versions.find(label);
+  if (it == versions.end()) {
+    return false;
+  }
+  releaseTree(it->second);
+  versions.erase(it);
+  return true;
+}
+
+std::vector<std::string> AVLTree::versionLabels() const {
+  std::vector<std::string> labels;
+  for (const auto &version : versions) {
+    labels.push_back(version.first);
+  }
+  return labels;
+}
+
+// ==================== CHANGE SETS ====================
+
+uint64_t AVLTree::contentHash() const {
+  loadRemaining();
+  settleHashes();
+  return getHash(root);
+}
+
+std::vector<TraceRecord> AVLTree::diff(const AVLTree &base) const {
+  PS5_TRACE_SPAN("diff");
+  loadRemaining();
+  base.loadRemaining();
+  settleHashes();
+  base.settleHashes();
+  std::vector<TraceRecord> changes;
+  diffHelper(root, base.root, true, INT_MIN - 1LL, INT_MAX + 1LL, changes);
+  return changes;
+}
+
+void AVLTree::applyChanges(const std::vector<TraceRecord> &changes) {
+  for (const TraceRecord &change : changes) {
+    replayRecord(*this, change);
+  }
+}
+
+// Changes between the students with lowID < ID < highID of two subtrees.
+// current holds exactly this tree's students in the range, base holds all of
+// base's (and exactly those if aligned, i.e. base has matched current's
+// shape so far).
+void AVLTree::diffHelper(const AVLNode *current, const AVLNode *base,
+                         bool aligned, long long lowID, long long highID,
+                         std::vector<TraceRecord> &changes) {
+  base = topInRange(base, lowID, highID);
+  if (current == base) {
+    return; // The same (shared) subtree, or both empty
+  }
+  if (current == nullptr) {
+    addRemovals(base, lowID, highID, changes);
+    return;
+  }
+  if (base == nullptr) {
+    addInsertions(current, changes);
+    return;
+  }
+  uint64_t baseHash = aligned ? base->hash : rangeHash(base, lowID, highID);
+  if (baseHash == current->hash) {
+    return;
+  }
+
+  int id = current->student_ID;
+  if (aligned && base->student_ID == id) {
+    diffHelper(current->left, base->left, true, lowID, id, changes);
+    diffStudent(base, current, changes);
+    diffHelper(current->right, base->right, true, id, highID, changes);
+    return;
+  }
+  const AVLNode *before = base;
+  while (before != nullptr && before->student_ID != id) {
+    before = id < before->student_ID ? before->left : before->right;
+  }
+  diffHelper(current->left, base, false, lowID, id, changes);
+  diffStudent(before, current, changes);
+  diffHelper(current->right, base, false, id, highID, changes);
+}
+
+// Highest node of a subtree with lowID < ID < highID, or nullptr
+const AVLNode *AVLTree::topInRange(const AVLNode *node, long long lowID,
+                                   long long highID) {
+  while (node != nullptr &&
+         (node->student_ID <= lowID || node->student_ID >= highID)) {
+    node = node->student_ID <= lowID ? node->right : node->left;
+  }
+  return node;
+}
+
+// Sum of the record hashes of the students in the range: the top node in
+// range, plus the part of its left subtree above lowID and of its right
+// subtree below highID, each summed along one path
+uint64_t AVLTree::rangeHash(const AVLNode *node, long long lowID,
+                            long long highID) {
+  node = topInRange(node, lowID, highID);
+  if (node == nullptr) {
+    return 0;
+  }
+  uint64_t sum = node->recordHash;
+  for (const AVLNode *n = node->left; n != nullptr;) {
+    if (n->student_ID > lowID) {
+      sum += n->recordHash + getHash(n->right);
+      n = n->left;
+    } else {
+      n = n->right;
+    }
+  }
+  for (const AVLNode *n = node->right; n != nullptr;) {
+    if (n->student_ID < highID) {
+      sum += n->recordHash + getHash(n->left);
+      n = n->right;
+    } else {
+      n = n->left;
+    }
+  }
+  return sum;
+}
+
+// Changes that turn before (nullptr if the student is new) into after.
+// Courses are added and updated before any is deleted, since a student's
+// last course cannot be deleted.
+void AVLTree::diffStudent(const AVLNode *before, const AVLNode *after,
+                          std::vector<TraceRecord> &changes) {
+  if (before != nullptr && before->recordHash == after->recordHash) {
+    return;
+  }
+  int id = after->student_ID;
+  std::string_view name = after->getName();
+  if (before != nullptr && before->getName() != name) {
+    changes.push_back({TraceRecord::DELETE_STUDENT, id, "", "", 0.0f});
+    before = nullptr;
+  }
+
+  if (before == nullptr) {
+    // The first course creates the student
+    TraceRecord::Kind kind = TraceRecord::INSERT;
+    for (const auto &course : after->getCourses()) {
+      changes.push_back({kind, id,
+                         std::string(kind == TraceRecord::INSERT ? name : ""),
+                         std::string(course.courseName.view()),
+                         course.grade});
+      kind = TraceRecord::ADD_COURSE;
+    }
+    return;
+  }
+
+  for (const auto &course : after->getCourses()) {
+    std::string_view courseName = course.courseName.view();
+    const CourseRecord *previous = before->findCourse(courseName);
+    if (previous == nullptr) {
+      changes.push_back({TraceRecord::ADD_COURSE, id, "",
+                         std::string(courseName), course.grade});
+    } else if (previous->grade != course.grade) {
+      changes.push_back({TraceRecord::UPDATE_COURSE, id, "",
+                         std::string(courseName), course.grade});
+    }
+  }
+  for (const auto &course : before->getCourses()) {
+    if (!after->hasCourse(course.courseName.view())) {
+      changes.push_back({TraceRecord::DELETE_COURSE, id, "",
+                         std::string(course.courseName.view()), 0.0f});
+    }
+  }
+}
+
+// Every student of a subtree is new
+void AVLTree::addInsertions(const AVLNode *node,
+                            std::vector<TraceRecord> &changes) {
+  if (node != nullptr) {
+    addInsertions(node->left, changes);
+    diffStudent(nullptr, node, changes);
+    addInsertions(node->right, changes);
+  }
+}
+
+// Every student of a subtree in the range was removed
+void AVLTree::addRemovals(const AVLNode *node, long long lowID,
+                          long long highID,
+                          std::vector<TraceRecord> &changes) {
+  if (node == nullptr) {
+    return;
+  }
+  if (node->student_ID > lowID) {
+    addRemovals(node->left, lowID, highID, changes);
+  }
+  if (node->student_ID > lowID && node->student_ID < highID) {
+    changes.push_back(
+        {TraceRecord::DELETE_STUDENT, node->student_ID, "", "", 0.0f});
+  }
+  if (node->student_ID < highID) {
+    addRemovals(node->right, lowID, highID, changes);
+  }
 }
@@ -6,33 +6,267 @@
  * Defines the AVLTree class - a self-balancing binary search tree
  * for efficient student grade management. Supports multiple courses per
  * student.
+ *
+ * The tree is persistent: nodes are reference counted and shared between the
+ * live tree, saved versions and copies of the tree. A node that is shared is
+ * path-copied before it is modified, so saving a version costs O(1) and each
+ * later change costs O(log n) extra memory while the version is kept.
+ *
+ * A tree created empty also keeps a StudentIndex from student ID to node, so
+ * search() and the lookups inside updates are O(1), a NameIndex for prefix
+ * and fuzzy name searches and a CourseIndex for cohort queries. While no
+ * other tree or saved version shares its nodes, course updates modify the
+ * indexed node in place instead of walking the path. Copies of a tree and
+ * trees returned by getVersion() have no index and search the tree
+ * (O(log n)).
+ *
+ * A tree filled by loadLazily() reads its CSV file block by block: the first
+ * operation on a student loads the block holding that student, and
+ * operations over all students (display, save, rank, copies, snapshots)
+ * first load whatever is left.
+ *
+ * loadExternal() loads files too large to sort in memory: the rows are
+ * sorted by student ID on disk (see ExternalSort.h) and the tree is built
+ * bottom-up from the sorted students.
+ *
+ * A tiered tree (enableTiering) keeps only recently used student records in
+ * memory and pages the others out to disk (see RecordPager.h).
+ *
+ * Every node keeps a hash of its subtree's records, so diff() finds the
+ * changes between two trees (e.g. the live tree and a snapshot, or a copy
+ * loaded from last night's export) by skipping the subtrees whose hashes
+ * match. A course edited in place leaves the hashes above it out of date
+ * until they are next needed (see settleHashes).
  */
 
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
 #include "AVLNode.h"
+#include "CourseIndex.h"
+#include "NameIndex.h"
+#include "StudentIndex.h"
+#include "WorkloadTrace.h"
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class AVLTree;
+class FrozenLayout;
+class RecordPager;
+
+// What AVLTree::merge does when both trees have a student ID
+enum MergePolicy {
+  KEEP_EXISTING, // Keep this tree's record
+  KEEP_INCOMING, // Replace it with the other tree's record
+  MERGE_COURSES  // Keep this record, add the other's courses (its grades win)
+};
+
+// A student found by a name search
+struct StudentMatch {
+  AVLNode *student;
+  int distance; // Edit distance of the name (0 for prefix matches)
+};
+
+/**
+ * One student's record, found once (AVLTree::lookup, findOrCreate, upsert)
+ * and then read and edited without searching the tree again. Edits through
+ * the handle behave like the tree operations of the same name: they are
+ * recorded in a workload trace, and a record shared with a saved version or
+ * copy is path-copied (once) before it changes.
+ * A handle stays valid until the next operation on its tree that is not
+ * made through it. An empty handle (student not found) converts to false
+ * and its edits return false.
+ */
+class StudentHandle {
+private:
+  AVLTree *tree;
+  int studentID;
+  AVLNode *node;
+  bool created; // The student was added by findOrCreate
+  bool owned;   // node is on the tree's own path and needs no copying
+
+  friend class AVLTree;
+  StudentHandle(AVLTree *owner, int student_ID, AVLNode *student,
+                bool isNew);
+
+public:
+  StudentHandle();
+
+  explicit operator bool() const { return node != nullptr; }
+  const AVLNode *operator->() const { return node; }
+  const AVLNode &operator*() const { return *node; }
+  const AVLNode *get() const { return node; }
+  int getStudentID() const { return studentID; }
+
+  /**
+   * True if findOrCreate (or upsert) created the student
+   */
+  bool wasCreated() const { return created; }
+
+  /**
+   * Course edits, as AVLTree::addCourseToStudent, updateCourse and
+   * deleteCourse
+   * Time Complexity: O(1) expected when the tree is indexed and unshared,
+   * else O(log n) for the first edit and O(1) expected after it
+   */
+  bool addCourse(std::string_view courseName, float grade);
+  bool updateCourse(std::string_view courseName, float newGrade);
+  bool deleteCourse(std::string_view courseName);
+
+  /**
+   * Add the course, or update its grade if the student already has it
+   */
+  bool setCourse(std::string_view courseName, float grade);
+};
 
 class AVLTree {
 private:
   AVLNode *root;
+  std::map<std::string, AVLNode *> versions; // Saved roots by label
+  WorkloadRecorder *recorder; // Trace of operations, or nullptr
+
+  // ID -> node, name and course indexes for the live tree (only maintained
+  // while indexed)
+  StudentIndex index;
+  NameIndex names;
+  CourseIndex courses;
+  bool indexed;
+
+  // Share groups of this tree: every tree that may share nodes with this
+  // one (copies, trees assigned from it, versions it hands out, trees merged
+  // into it) holds one of them. If each has use_count() == 1, no other tree
+  // shares this tree's nodes.
+  std::vector<std::shared_ptr<char>> shareGroups;
+
+  // File the tree is being loaded from on demand, or nullptr (see
+  // loadLazily)
+  struct LazyFile;
+  std::unique_ptr<LazyFile> lazy;
+
+  // Read-only search layout while frozen (see freeze), or nullptr
+  std::unique_ptr<FrozenLayout> frozen;
+
+  // Pager of the records of new students (see enableTiering), or nullptr;
+  // the tree holds a reference
+  RecordPager *pager;
+
+  // Students whose record was edited since the subtree hashes above them
+  // were last recomputed, or every student if rehashAll. Only nodes no
+  // other tree shares can be out of date: hashes are settled before nodes
+  // are shared.
+  mutable std::vector<int> staleHashes;
+  mutable bool rehashAll;
 
   // Helper functions for AVL operations
   int getHeight(AVLNode *node);
+  int getSize(AVLNode *node);
   int getBalance(AVLNode *node);
+  void updateNode(AVLNode *node);
+  static uint64_t getHash(const AVLNode *node);
   AVLNode *rotateLeft(AVLNode *node);
   AVLNode *rotateRight(AVLNode *node);
-  AVLNode *findMinNode(AVLNode *node);
+  AVLNode *rebalance(AVLNode *node);
+
+  // Persistence helpers
+  AVLNode *ownNode(AVLNode *node);
+  AVLNode *ownPath(int student_ID);
+  AVLNode *findNode(int student_ID);
+  AVLNode *writableNode(int student_ID);
+  bool sharesNodes() const;
+  bool sharesWithOtherTrees() const;
+  void joinShareGroups(const AVLTree &other);
+  const NameIndex &nameIndex(NameIndex &scratch) const;
+  template <typename Course>
+  void addCourseToExisting(AVLNode *node, Course &&course, float grade);
+  static void retainTree(AVLNode *node);
+  static void releaseTree(AVLNode *node);
+
+  // Subtree hash helpers
+  void markHashStale(int student_ID);
+  void settleHashes() const;
+  static void rehashSubtree(AVLNode *node);
+
+  // Student handle helpers
+  friend class StudentHandle;
+  StudentHandle findHandle(int student_ID);
+  AVLNode *writableNode(StudentHandle &student);
+
+  // Tiered storage helpers
+  void attachTree(AVLNode *node);
+  void usePager(RecordPager *newPager);
+  void trimRecords();
+  static void endScan(const AVLNode *node, bool wasResident);
+
+  // Bottom-up building from students sorted by ID (see loadExternal). Each
+  // spine entry is a perfect subtree and the node that follows it.
+  typedef std::vector<std::pair<AVLNode *, AVLNode *>> SortedSpine;
+  void appendSorted(SortedSpine &spine, AVLNode *node);
+  AVLNode *finishSorted(SortedSpine &spine);
+
+  // Lazy loading helpers
+  void faultIn(int student_ID);
+  void loadRemaining() const;
+  void loadBlock(size_t block);
+  void loadRow(int student_ID, std::string &&name, std::string &&course,
+               float grade);
+
+  // Index a newly created node and page its record if tiered
+  void adoptNode(AVLNode *created);
+  void indexCourses(const AVLNode *student);
+  void unindexCourses(const AVLNode *student);
 
   // Recursive helper functions
-  AVLNode *insertHelper(AVLNode *node, int student_ID, const std::string &name,
-                        const std::string &course, float grade);
+  // Name/Course are const std::string& or std::string&& (see insert)
+  template <typename Name, typename Course>
+  AVLNode *insertHelper(AVLNode *node, int student_ID, Name &&name,
+                        Course &&course, float grade,
+                        AVLNode **created = nullptr);
   AVLNode *deleteHelper(AVLNode *node, int student_ID);
+  AVLNode *detachMin(AVLNode *node, AVLNode *&minNode);
+  AVLNode *regradeHelper(AVLNode *node);
+
+  // Join/split primitives. They consume one reference to each subtree passed
+  // in and return owned references.
+  AVLNode *join(AVLNode *left, AVLNode *mid, AVLNode *right);
+  AVLNode *joinRight(AVLNode *left, AVLNode *mid, AVLNode *right);
+  AVLNode *joinLeft(AVLNode *left, AVLNode *mid, AVLNode *right);
+  void split(AVLNode *node, int student_ID, AVLNode *&less, AVLNode *&found,
+             AVLNode *&greater);
+  AVLNode *unionHelper(AVLNode *mine, AVLNode *theirs, MergePolicy policy);
+  AVLNode *resolveConflict(AVLNode *mine, AVLNode *theirs, MergePolicy policy);
+  void indexSubtree(AVLNode *node);
   AVLNode *searchHelper(AVLNode *node, int student_ID);
+  void descendMany(const std::vector<int> &studentIDs,
+                   std::vector<AVLNode *> &nodes);
   void inorderTraversal(AVLNode *node);
-  void saveToFileHelper(AVLNode *node, std::ofstream &file);
-  void destroyTree(AVLNode *node);
+  static void forEachHelper(const AVLNode *node,
+                            const std::function<void(const AVLNode &)> &visit);
+  static void rangeHelper(const AVLNode *node, int lowID, int highID,
+                          const std::function<void(const AVLNode &)> &visit);
+  void saveToFileHelper(const AVLNode *node, std::ostream &out,
+                        std::atomic<int> *studentsWritten) const;
+
+  // Change set helpers (see diff); the ID bounds are exclusive
+  static void diffHelper(const AVLNode *current, const AVLNode *base,
+                         bool aligned, long long lowID, long long highID,
+                         std::vector<TraceRecord> &changes);
+  static const AVLNode *topInRange(const AVLNode *node, long long lowID,
+                                   long long highID);
+  static uint64_t rangeHash(const AVLNode *node, long long lowID,
+                            long long highID);
+  static void diffStudent(const AVLNode *before, const AVLNode *after,
+                          std::vector<TraceRecord> &changes);
+  static void addInsertions(const AVLNode *node,
+                            std::vector<TraceRecord> &changes);
+  static void addRemovals(const AVLNode *node, long long lowID,
+                          long long highID, std::vector<TraceRecord> &changes);
 
 public:
   /**
@@ -41,7 +275,17 @@ public:
   AVLTree();
 
   /**
-   * Destructor - Cleans up all nodes in the tree
+   * Copy constructor - Shares all nodes with other (saved versions and the
+   * workload recorder are not copied). Either tree can then be modified
+   * without affecting the other.
+   * Time Complexity: O(1)
+   */
+  AVLTree(const AVLTree &other);
+  AVLTree &operator=(const AVLTree &other);
+
+  /**
+   * Destructor - Releases this tree's references; nodes still shared with
+   * another version or copy stay alive
    */
   ~AVLTree();
 
@@ -49,40 +293,145 @@ public:
    * Insert a new course for a student
    * If student exists, adds course to their record
    * If student doesn't exist, creates new student with this course
-   * Time Complexity: O(log n)
+   * Time Complexity: O(log n) for a new student; adding to an existing one
+   * is O(1) expected when indexed and unshared
    */
   void insert(int student_ID, const std::string &name,
               const std::string &course, float grade);
 
+  /**
+   * Insert - Same as above, but moves the name and course strings into the
+   * record instead of copying them (the name is only consumed for a new
+   * student, the course only if it was added)
+   */
+  void insert(int student_ID, std::string &&name, std::string &&course,
+              float grade);
+
   /**
    * Search for a student record by ID
-   * Time Complexity: O(log n)
+   * Time Complexity: O(1) expected with the index, O(log n) without
    * @return Pointer to the node if found, nullptr otherwise
    */
   AVLNode *search(int student_ID);
 
   /**
-   * Update a specific course grade for a student
+   * Search for a student and return a handle for reading and editing the
+   * record (see StudentHandle); recorded and timed like search()
+   * Time Complexity: O(1) expected with the index, O(log n) without
+   * @return The handle, empty if the student is not found
+   */
+  StudentHandle lookup(int student_ID);
+
+  /**
+   * Find a student, or create them with this name and first course if they
+   * are not in the tree. name and course are only moved from when the
+   * student is created; an existing student is returned unchanged.
+   * Time Complexity: O(1) expected to find a student with the index,
+   * O(log n) to create one or to search without the index
+   */
+  StudentHandle findOrCreate(int student_ID, std::string &&name,
+                             std::string &&course, float grade);
+
+  /**
+   * Make sure a student has a course with this grade: create the student,
+   * add the course or update its grade
+   * Time Complexity: as findOrCreate, plus O(1) expected for the course
+   */
+  StudentHandle upsert(int student_ID, std::string &&name,
+                       std::string &&course, float grade);
+
+  /**
+   * Look up many students at once. With the index, each group of hash slots
+   * is prefetched before it is probed; without it (copies, versions), a
+   * group of descents advances one level per round and prefetches every
+   * next child, so the cache misses of different lookups overlap.
+   * Time Complexity: O(k) expected with the index, O(k log n) without
+   * @param nodes Resized to studentIDs.size(); receives each student's node
+   *              or nullptr
+   */
+  void searchMany(const std::vector<int> &studentIDs,
+                  std::vector<AVLNode *> &nodes);
+
+  /**
+   * Read-only search that is neither timed nor recorded. Safe to call from
+   * several threads at once on a tree no thread modifies, such as a
+   * ConcurrentTree snapshot.
+   * Time Complexity: O(1) expected with the index, O(log n) without
+   */
+  const AVLNode *find(int student_ID) const;
+
+  /**
+   * Students with a name word starting with prefix (case-insensitive),
+   * e.g. "jo" finds "John Smith" and "Mary Jones"
+   * Time Complexity: O(log n + k) with the index, O(n log n) without
+   */
+  std::vector<StudentMatch> searchByNamePrefix(std::string_view prefix,
+                                               size_t limit = 50);
+
+  /**
+   * Students whose name is within maxDistance edits (insertions, deletions,
+   * substitutions) of name, compared case-insensitively and word-aligned:
+   * "jon" matches "John Smith" at distance 1. Closest matches come first.
+   */
+  std::vector<StudentMatch> searchByNameFuzzy(std::string_view name,
+                                              int maxDistance,
+                                              size_t limit = 50);
+
+  /**
+   * Students by course enrolment, e.g. everyone who took both "Data
+   * Structures" and "Algorithms" but not "Operating Systems" (see
+   * CohortQuery). Uses the course posting lists (see CourseIndex.h).
+   * Time Complexity: about the length of the shortest list involved with
+   * the index; O(n * m) without it (copies, versions), and O(n) for a query
+   * with only noneOf courses
+   * @return IDs of the matching students in increasing order
+   */
+  std::vector<int> cohort(const CohortQuery &query);
+
+  /**
+   * Rank of a student in student ID order (number of students with a
+   * smaller ID), using subtree sizes kept in every node
    * Time Complexity: O(log n)
+   * @return 0-based rank, or -1 if the student is not in the tree
+   */
+  int rank(int student_ID) const;
+
+  /**
+   * Number of students in the tree
+   * Time Complexity: O(1)
+   */
+  int size() const;
+
+  /**
+   * Update a specific course grade for a student
+   * Time Complexity: O(1) expected when indexed and unshared, else O(log n)
    * @return true if update successful, false if student or course not found
    */
-  bool updateCourse(int student_ID, const std::string &courseName,
+  bool updateCourse(int student_ID, std::string_view courseName,
                     float newGrade);
 
   /**
    * Add a new course to an existing student
-   * Time Complexity: O(log n)
+   * Time Complexity: O(1) expected when indexed and unshared, else O(log n)
    * @return true if successful, false if student not found or course exists
    */
-  bool addCourseToStudent(int student_ID, const std::string &courseName,
+  bool addCourseToStudent(int student_ID, std::string_view courseName,
                           float grade);
 
+  /**
+   * Print the outcome of adding a course to an existing student, as insert
+   * does: the new GPA if it was added, else a note that it already exists
+   * Time Complexity: O(1)
+   */
+  static void reportCourseAdded(const AVLNode *student,
+                                std::string_view courseName, bool added);
+
   /**
    * Delete a specific course from a student
-   * Time Complexity: O(log n)
+   * Time Complexity: O(1) expected when indexed and unshared, else O(log n)
    * @return true if successful, false otherwise
    */
-  bool deleteCourse(int student_ID, const std::string &courseName);
+  bool deleteCourse(int student_ID, std::string_view courseName);
 
   /**
    * Delete an entire student record
@@ -90,6 +439,20 @@ public:
    */
   void deleteStudent(int student_ID);
 
+  /**
+   * Visit every student in increasing student ID order (in a tiered tree, a
+   * record paged in for the visit is paged out again right after it)
+   * Time Complexity: O(n)
+   */
+  void forEachStudent(const std::function<void(const AVLNode &)> &visit) const;
+
+  /**
+   * Visit the students with lowID <= ID <= highID in increasing ID order
+   * Time Complexity: O(log n + k)
+   */
+  void forEachInRange(int lowID, int highID,
+                      const std::function<void(const AVLNode &)> &visit) const;
+
   /**
    * Display all student records in sorted order (by student ID)
    * Shows all courses for each student
@@ -98,21 +461,196 @@ public:
   void display();
 
   /**
-   * Save all student records to a CSV file
+   * Save all student records to a CSV file (or to a compact archive if the
+   * filename ends in ".gca", see GradeArchive.h)
+   * The data is written to "<filename>.tmp" which then atomically replaces
+   * the old file, so a failed save never leaves a truncated file behind.
    * Time Complexity: O(n * m)
    */
   void saveToFile(const std::string &filename);
 
   /**
-   * Load student records from a CSV file
+   * Write all student records as CSV (with header) without printing
+   * Safe to call from a background thread on a copy of the tree while the
+   * original is being edited (see BackgroundSave).
+   * @param studentsWritten If given, incremented after each student
+   * @return true if the stream is still good afterwards
+   */
+  bool writeCSV(std::ostream &out,
+                std::atomic<int> *studentsWritten = nullptr) const;
+
+  /**
+   * Load student records from a CSV file (or a ".gca" archive)
    * Time Complexity: O(n log n)
+   * @return false if the file could not be opened or the archive is damaged
+   */
+  bool loadFromFile(const std::string &filename);
+
+  /**
+   * Load a CSV file on demand: only its offset index (see OffsetIndex.h) is
+   * read now, and each block of rows is added the first time one of its
+   * students is used. Archives, files not sorted by student ID and loads
+   * into a non-empty tree fall back to loadFromFile().
+   * Time Complexity: O(b) for b blocks (O(file size) when the index has to
+   * be rebuilt); later, O(block size) for the first use of each block
    */
-  void loadFromFile(const std::string &filename);
+  void loadLazily(const std::string &filename);
+
+  /**
+   * Load a CSV file with bounded memory for sorting: its rows are sorted by
+   * student ID in runs of about memoryLimitBytes, spilled to disk and merged
+   * (see ExternalSort.h), and the sorted students are linked into a balanced
+   * tree bottom-up without rotations. The limit covers the sort only; the
+   * tree still needs its nodes and indexes, and its records unless it is
+   * tiered (enableTiering). Archives and loads into a non-empty tree fall
+   * back to loadFromFile().
+   * Time Complexity: O(N log N) for N rows, plus O(N) to build the tree and
+   * one pass over the run files per merge pass
+   */
+  void loadExternal(const std::string &filename, size_t memoryLimitBytes);
 
   /**
    * Check if the tree is empty
    */
   bool isEmpty() const;
+
+  /**
+   * Record every following operation on this tree (see WorkloadTrace.h);
+   * nullptr stops recording. The recorder must outlive the tree's use of it.
+   */
+  void setRecorder(WorkloadRecorder *workloadRecorder);
+
+  /**
+   * Recompute every student's GPA under the current grading policy (after
+   * setGradingPolicy, see GradingScale.h). Saved versions keep the GPAs they
+   * were saved with.
+   * Time Complexity: O(n * m)
+   */
+  void regradeAll();
+
+  // ==================== FROZEN LAYOUT ====================
+
+  /**
+   * Build a read-only search layout of the current students (see
+   * FrozenLayout.h) for a period without edits. While frozen, rank and
+   * forEachInRange use it, as do lookups in copies (which have no ID hash
+   * index). The first edit thaws the tree automatically.
+   * Time Complexity: O(n); uses 16 bytes per student
+   */
+  void freeze();
+
+  /**
+   * Drop the frozen layout (no effect if the tree is not frozen)
+   */
+  void thaw();
+
+  bool isFrozen() const;
+
+  // ==================== TIERED STORAGE ====================
+
+  /**
+   * Keep only the most recently used student records in memory, within
+   * budgetBytes, and page the others out to pageFile (created empty and
+   * deleted when no tree uses it any more; see RecordPager.h). Records are
+   * paged back in transparently when read. Copies of the tree share its
+   * pager. Calling it again changes the budget.
+   * The tree and its copies must then be used from one thread only.
+   * Time Complexity: O(n) to page out the records over the budget
+   * @return false if the file cannot be created or a copy of the tree
+   *         exists
+   */
+  bool enableTiering(const std::string &pageFile, size_t budgetBytes);
+
+  bool isTiered() const;
+
+  /**
+   * The pager (for statistics), or nullptr if the tree is not tiered
+   */
+  const RecordPager *recordPager() const { return pager; }
+
+  // ==================== JOIN, SPLIT AND MERGE ====================
+
+  /**
+   * Merge all students of other into this tree (other is unchanged). A
+   * student in both trees is resolved by policy.
+   * The trees share the untouched subtrees of other afterwards, like a copy.
+   * Operations on this tree made by merge are not written to a workload
+   * trace.
+   * Time Complexity: O(m log(n/m + 1)) for sizes m <= n, plus O(k) index
+   * updates for the k students taken from other
+   */
+  void merge(const AVLTree &other, MergePolicy policy);
+
+  /**
+   * The students with lowID <= ID <= highID as a tree of their own (this
+   * tree is unchanged). The result shares nodes with this tree and, like a
+   * copy, has no index.
+   * Time Complexity: O(log n)
+   */
+  AVLTree splitRange(int lowID, int highID) const;
+
+  // ==================== VERSIONS (SEMESTER SNAPSHOTS) ====================
+
+  /**
+   * Freeze the current contents under a label (e.g. "Spring 2025")
+   * Replaces any version already saved under that label.
+   * Time Complexity: O(1)
+   */
+  void saveVersion(const std::string &label);
+
+  /**
+   * Get a saved version as a tree of its own for historical queries
+   * The result shares structure with this tree; editing it does not change
+   * the saved version.
+   * Time Complexity: O(log v) for v saved versions
+   * @return The saved tree, or an empty tree if the label is unknown
+   */
+  AVLTree getVersion(const std::string &label) const;
+
+  bool hasVersion(const std::string &label) const;
+
+  /**
+   * Forget a saved version, freeing nodes no other version uses
+   * @return true if the label existed
+   */
+  bool dropVersion(const std::string &label);
+
+  /**
+   * Labels of all saved versions, in sorted order
+   */
+  std::vector<std::string> versionLabels() const;
+
+  // ==================== CHANGE SETS ====================
+
+  /**
+   * Hash of all student records (IDs, names, courses and grades). It is a
+   * sum of one hash per student, so trees with the same contents have the
+   * same hash whatever their shape.
+   * Time Complexity: O(1), after O(log n) per course edited in place since
+   * the last hash was needed
+   */
+  uint64_t contentHash() const;
+
+  /**
+   * The changes that turn base into this tree, in student ID order, as
+   * operations that applyChanges replays (writeChangeSet saves them as a
+   * trace file, see WorkloadTrace.h): INSERT and ADD_COURSE for new students,
+   * DELETE_STUDENT for removed ones, and ADD_COURSE, UPDATE_COURSE and
+   * DELETE_COURSE for changed ones (a renamed student is deleted and
+   * inserted again).
+   * Subtrees whose hashes match are skipped. Where base has the same shape
+   * (a snapshot or copy of this tree) the subtrees line up and are compared
+   * directly; otherwise base's hash of each range is summed along two paths.
+   * Time Complexity: O(d log n) for d changed students in a tree of the
+   * same shape, O(d log^2 n) otherwise
+   */
+  std::vector<TraceRecord> diff(const AVLTree &base) const;
+
+  /**
+   * Replay a change set made by diff (recorded like other operations)
+   * Time Complexity: O(k log n) for k changes
+   */
+  void applyChanges(const std::vector<TraceRecord> &changes);
 };
 
 #endif // AVLTREE_H
@@ -0,0 +1,97 @@
+/**
+ * BackgroundSave.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the background CSV save.
+ */
+
+#include "BackgroundSave.h"
+#include "GradeArchive.h"
+#include "Metrics.h"
+#include <cstdio>
+#include <fstream>
+
+BackgroundSave::BackgroundSave()
+    : studentsTotal(0), studentsWritten(0), state(IDLE) {}
+
+BackgroundSave::~BackgroundSave() { wait(); }
+
+bool BackgroundSave::start(const AVLTree &tree, const std::string &filename) {
+  if (collect() == RUNNING) {
+    return false; // Previous save still running
+  }
+
+  snapshot = tree; // O(1): shares all nodes with the live tree
+  target = filename;
+  studentsTotal = snapshot.size();
+  studentsWritten.store(0);
+  state.store(RUNNING);
+  if (tree.isTiered()) {
+    // Reading a tiered tree pages records in and out, which only the
+    // owning thread may do
+    run();
+    return true;
+  }
+  worker = std::thread(&BackgroundSave::run, this);
+  return true;
+}
+
+// Worker thread: serialize the snapshot and atomically replace the file
+void BackgroundSave::run() {
+  PS5_TIME_OP(SAVE_FILE);
+  PS5_TRACE_SPAN("backgroundSave");
+  std::string tempName = target + ".tmp";
+  bool ok = false;
+  uint64_t started = PS5_CLOCK();
+  {
+    bool archive = isArchiveFilename(target);
+    std::ofstream file(tempName, archive ? std::ios::out | std::ios::binary
+                                         : std::ios::out);
+    if (file.is_open()) {
+      ok = archive ? writeArchive(snapshot, file, &studentsWritten)
+                   : snapshot.writeCSV(file, &studentsWritten);
+      file.close();
+      ok = ok && !file.fail();
+    }
+  }
+
+  uint64_t wrote = PS5_CLOCK();
+  PS5_PHASE(SAVE_WRITE, wrote - started, 1);
+
+  bool renamed = ok && std::rename(tempName.c_str(), target.c_str()) == 0;
+  PS5_PHASE(SAVE_RENAME, PS5_CLOCK() - wrote, 1);
+
+  if (renamed) {
+    state.store(SUCCEEDED);
+  } else {
+    std::remove(tempName.c_str());
+    state.store(FAILED);
+  }
+}
+
+// Join the worker and release the snapshot on the owning thread
+BackgroundSave::Status BackgroundSave::finish() {
+  if (worker.joinable()) {
+    worker.join();
+  }
+  snapshot = AVLTree();
+  Status status = static_cast<Status>(state.load());
+  state.store(IDLE);
+  return status;
+}
+
+BackgroundSave::Status BackgroundSave::collect() {
+  int current = state.load();
+  if (current == IDLE || current == RUNNING) {
+    return static_cast<Status>(current);
+  }
+  return finish();
+}
+
+BackgroundSave::Status BackgroundSave::wait() {
+  if (state.load() == IDLE) {
+    return IDLE;
+  }
+  return finish();
+}
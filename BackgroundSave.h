@@ -0,0 +1,77 @@
+/**
+ * BackgroundSave.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Defines the BackgroundSave class - saves a point-in-time snapshot of an
+ * AVLTree to CSV on a worker thread while the menu keeps running.
+ *
+ * The snapshot is an O(1) copy of the tree that shares every node with it.
+ * Edits made meanwhile path-copy the shared nodes (see AVLTree), so the
+ * worker sees exactly the data present when the save started. The file is
+ * written to "<filename>.tmp" and renamed over the old file when complete.
+ *
+ * All methods must be called from the thread that owns the tree; only the
+ * serialization itself runs on the worker. A tiered tree (see RecordPager.h)
+ * is saved on the calling thread instead, before start() returns.
+ */
+
+#ifndef BACKGROUNDSAVE_H
+#define BACKGROUNDSAVE_H
+
+#include "AVLTree.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+class BackgroundSave {
+public:
+  enum Status { IDLE, RUNNING, SUCCEEDED, FAILED };
+
+private:
+  AVLTree snapshot;
+  std::thread worker;
+  std::string target;
+  int studentsTotal;
+  std::atomic<int> studentsWritten;
+  std::atomic<int> state;
+
+  void run();
+  Status finish();
+
+public:
+  BackgroundSave();
+
+  /**
+   * Destructor - Waits for a running save to finish
+   */
+  ~BackgroundSave();
+
+  BackgroundSave(const BackgroundSave &) = delete;
+  BackgroundSave &operator=(const BackgroundSave &) = delete;
+
+  /**
+   * Snapshot the tree and start writing it to filename
+   * Time Complexity: O(1) on the calling thread (O(n) for tiered trees)
+   * @return false if a save is already running
+   */
+  bool start(const AVLTree &tree, const std::string &filename);
+
+  /**
+   * Check on the save. A finished save is cleaned up and its result
+   * (SUCCEEDED or FAILED) is returned once; after that the status is IDLE.
+   */
+  Status collect();
+
+  /**
+   * Block until the running save (if any) has finished, then collect it
+   */
+  Status wait();
+
+  bool isRunning() const { return state.load() == RUNNING; }
+  int written() const { return studentsWritten.load(); }
+  int total() const { return studentsTotal; }
+  const std::string &filename() const { return target; }
+};
+
+#endif // BACKGROUNDSAVE_H
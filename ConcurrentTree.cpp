@@ -0,0 +1,64 @@
+/**
+ * ConcurrentTree.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of snapshot publishing and epoch-based reclamation.
+ */
+
+#include "ConcurrentTree.h"
+#include <thread>
+
+ConcurrentTree::ConcurrentTree(size_t maxReaders)
+    : published(new AVLTree(tree)), epoch(1),
+      slots(new ReaderSlot[maxReaders]), slotCount(maxReaders) {}
+
+ConcurrentTree::~ConcurrentTree() {
+  for (const auto &entry : retired) {
+    delete entry.second;
+  }
+  delete published.load();
+}
+
+void ConcurrentTree::publish() {
+  const AVLTree *old = published.exchange(new AVLTree(tree));
+  // Readers that announce a later epoch load the new snapshot
+  retired.emplace_back(epoch.fetch_add(1), old);
+  reclaim();
+}
+
+void ConcurrentTree::reclaim() {
+  uint64_t oldest = UINT64_MAX; // Oldest epoch still being read
+  for (size_t i = 0; i < slotCount; ++i) {
+    uint64_t reading = slots[i].epoch.load();
+    if (reading != 0 && reading < oldest) {
+      oldest = reading;
+    }
+  }
+
+  size_t kept = 0;
+  for (const auto &entry : retired) {
+    if (entry.first < oldest) {
+      delete entry.second; // Releases nodes no other tree uses
+    } else {
+      retired[kept++] = entry;
+    }
+  }
+  retired.resize(kept);
+}
+
+ConcurrentTree::Reader::Reader(ConcurrentTree &tree)
+    : owner(tree), slot(nullptr) {
+  for (;;) {
+    for (size_t i = 0; i < owner.slotCount; ++i) {
+      bool expected = false;
+      if (owner.slots[i].taken.compare_exchange_strong(expected, true)) {
+        slot = &owner.slots[i];
+        return;
+      }
+    }
+    std::this_thread::yield(); // All slots taken: wait for a Reader to go
+  }
+}
+
+ConcurrentTree::Reader::~Reader() { slot->taken.store(false); }
@@ -0,0 +1,122 @@
+/**
+ * ConcurrentTree.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Single-writer, multi-reader wrapper around AVLTree. Readers never lock.
+ *
+ * The writer edits a private tree and calls publish(), which makes an O(1)
+ * copy of it (see the persistent AVLTree) and swaps it in as the current
+ * snapshot with one atomic store. Published nodes are never modified again:
+ * the writer's next edits path-copy them. Readers load the current
+ * snapshot and traverse it without locks or reference counting.
+ *
+ * Replaced snapshots are reclaimed with epochs. Each reader announces the
+ * global epoch while it reads; a snapshot retired at epoch e is deleted by
+ * the writer once no reader still announces an epoch <= e. All reference
+ * counts are changed by the writer thread only.
+ *
+ * The writer's tree must not be tiered (AVLTree::enableTiering), since
+ * readers would page records in and out.
+ */
+
+#ifndef CONCURRENTTREE_H
+#define CONCURRENTTREE_H
+
+#include "AVLTree.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class ConcurrentTree {
+private:
+  // One per Reader; own cache line so readers do not contend
+  struct alignas(64) ReaderSlot {
+    std::atomic<uint64_t> epoch{0}; // Epoch of the read in progress, 0 = idle
+    std::atomic<bool> taken{false};
+  };
+
+  AVLTree tree; // The writer's tree
+  std::atomic<const AVLTree *> published;
+  std::atomic<uint64_t> epoch;
+  std::unique_ptr<ReaderSlot[]> slots;
+  size_t slotCount;
+  std::vector<std::pair<uint64_t, const AVLTree *>> retired; // Writer only
+
+  void reclaim();
+
+public:
+  /**
+   * Read access for one thread. At most maxReaders Readers exist at a time;
+   * constructing another waits until one is destroyed.
+   */
+  class Reader {
+  private:
+    ConcurrentTree &owner;
+    ReaderSlot *slot;
+
+  public:
+    explicit Reader(ConcurrentTree &tree);
+    ~Reader();
+    Reader(const Reader &) = delete;
+    Reader &operator=(const Reader &) = delete;
+
+    /**
+     * Call visit(snapshot) with the latest published snapshot. Nodes reached
+     * from it stay valid until visit returns. Use only const operations
+     * (find, rank, size, forEachStudent, writeCSV).
+     * Time Complexity: O(1) plus visit
+     */
+    template <typename Visit> auto read(Visit &&visit) {
+      struct Leave {
+        std::atomic<uint64_t> &epoch;
+        ~Leave() { epoch.store(0, std::memory_order_release); }
+      } leave{slot->epoch};
+      // Announce before loading, so the writer cannot miss this read
+      slot->epoch.store(owner.epoch.load());
+      const AVLTree *snapshot = owner.published.load();
+      return visit(*snapshot);
+    }
+  };
+
+  explicit ConcurrentTree(size_t maxReaders = 64);
+
+  /**
+   * Destructor - No Reader may still exist
+   */
+  ~ConcurrentTree();
+
+  ConcurrentTree(const ConcurrentTree &) = delete;
+  ConcurrentTree &operator=(const ConcurrentTree &) = delete;
+
+  /**
+   * The writer's tree. Only the writer thread may use it, and readers do
+   * not see its changes until publish().
+   */
+  AVLTree &writer() { return tree; }
+
+  /**
+   * Make the writer's current tree visible to readers, then delete old
+   * snapshots no reader can still be using
+   * Time Complexity: O(1) plus the nodes freed
+   */
+  void publish();
+
+  /**
+   * Apply edit(writer tree), then publish
+   */
+  template <typename Edit> void write(Edit &&edit) {
+    edit(tree);
+    publish();
+  }
+
+  /**
+   * Old snapshots waiting for readers to move on
+   */
+  size_t retiredCount() const { return retired.size(); }
+};
+
+#endif // CONCURRENTTREE_H
@@ -0,0 +1,250 @@
+/**
+ * CourseIndex.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the posting lists and the set operations on them.
+ */
+
+#include "CourseIndex.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// First position in ids[from, size) holding a value >= value, found by
+// doubling the step from from and then searching the last step
+size_t gallop(const int *ids, size_t size, size_t from, int value) {
+  size_t bound = 1;
+  while (from + bound < size && ids[from + bound] < value) {
+    bound *= 2;
+  }
+  const int *low = ids + from + bound / 2;
+  const int *high = ids + std::min(size, from + bound + 1);
+  return std::lower_bound(low, high, value) - ids;
+}
+
+// Intersection of a short list with a much longer one
+void intersectGallop(const std::vector<int> &shorter,
+                     const std::vector<int> &longer, std::vector<int> &out) {
+  size_t position = 0;
+  for (int id : shorter) {
+    position = gallop(longer.data(), longer.size(), position, id);
+    if (position == longer.size()) {
+      break;
+    }
+    if (longer[position] == id) {
+      out.push_back(id);
+    }
+  }
+}
+
+// Intersection of two lists of similar length. Each step compares a block
+// of four IDs of a with all four of a block of b (b rotated three times),
+// emits the IDs of a that matched and moves past the block with the
+// smaller last ID (both if equal).
+void intersectMerge(const std::vector<int> &a, const std::vector<int> &b,
+                    std::vector<int> &out) {
+  size_t i = 0, j = 0;
+#if defined(__SSE2__)
+  while (i + 4 <= a.size() && j + 4 <= b.size()) {
+    __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&a[i]));
+    __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&b[j]));
+    __m128i equal = _mm_or_si128(
+        _mm_or_si128(
+            _mm_cmpeq_epi32(blockA, blockB),
+            _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x39))),
+        _mm_or_si128(
+            _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x4E)),
+            _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, 0x93))));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+    while (mask != 0) {
+      out.push_back(a[i + __builtin_ctz(mask)]);
+      mask &= mask - 1;
+    }
+    int lastA = a[i + 3], lastB = b[j + 3];
+    if (lastA <= lastB) {
+      i += 4;
+    }
+    if (lastB <= lastA) {
+      j += 4;
+    }
+  }
+#endif
+  while (i < a.size() && j < b.size()) {
+    if (a[i] < b[j]) {
+      i++;
+    } else if (b[j] < a[i]) {
+      j++;
+    } else {
+      out.push_back(a[i]);
+      i++;
+      j++;
+    }
+  }
+}
+
+} // namespace
+
+// ==================== POSTING LISTS ====================
+
+void CourseIndex::add(std::string_view course, int studentID) {
+  PostingList &list = lists[std::string(course)];
+  if (list.added.empty() && list.removed.empty() &&
+      (list.ids.empty() || list.ids.back() < studentID)) {
+    list.ids.push_back(studentID); // Still sorted
+  } else {
+    list.added.push_back(studentID);
+  }
+}
+
+void CourseIndex::remove(std::string_view course, int studentID) {
+  auto it = lists.find(std::string(course));
+  if (it == lists.end()) {
+    return;
+  }
+  PostingList &list = it->second;
+  if (list.added.empty() && list.removed.empty() && !list.ids.empty() &&
+      list.ids.back() == studentID) {
+    list.ids.pop_back();
+  } else {
+    list.removed.push_back(studentID);
+  }
+}
+
+// Merge the pending changes into the sorted list. A student is only added
+// while absent and removed while present, so counting each ID in ids and
+// added, minus its count in removed, leaves 0 or 1.
+void CourseIndex::settle(PostingList &list) {
+  if (list.added.empty() && list.removed.empty()) {
+    return;
+  }
+  std::sort(list.added.begin(), list.added.end());
+  std::sort(list.removed.begin(), list.removed.end());
+  std::vector<int> merged;
+  merged.reserve(list.ids.size() + list.added.size());
+  std::merge(list.ids.begin(), list.ids.end(), list.added.begin(),
+             list.added.end(), std::back_inserter(merged));
+  list.ids.clear();
+  std::set_difference(merged.begin(), merged.end(), list.removed.begin(),
+                      list.removed.end(), std::back_inserter(list.ids));
+  list.added.clear();
+  list.removed.clear();
+}
+
+const std::vector<int> *CourseIndex::find(const std::string &course) {
+  auto it = lists.find(course);
+  if (it == lists.end()) {
+    return nullptr;
+  }
+  settle(it->second);
+  return &it->second.ids;
+}
+
+const std::vector<int> &CourseIndex::students(const std::string &course) {
+  static const std::vector<int> none;
+  const std::vector<int> *ids = find(course);
+  return ids != nullptr ? *ids : none;
+}
+
+// ==================== SET OPERATIONS ====================
+
+void CourseIndex::intersect(const std::vector<int> &a,
+                            const std::vector<int> &b, std::vector<int> &out) {
+  out.clear();
+  const std::vector<int> &shorter = a.size() <= b.size() ? a : b;
+  const std::vector<int> &longer = a.size() <= b.size() ? b : a;
+  if (longer.size() / GALLOP_RATIO > shorter.size()) {
+    intersectGallop(shorter, longer, out);
+  } else {
+    intersectMerge(a, b, out);
+  }
+}
+
+void CourseIndex::unite(const std::vector<int> &a, const std::vector<int> &b,
+                        std::vector<int> &out) {
+  out.clear();
+  std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                 std::back_inserter(out));
+}
+
+void CourseIndex::subtract(const std::vector<int> &a,
+                           const std::vector<int> &b, std::vector<int> &out) {
+  out.clear();
+  if (b.size() / GALLOP_RATIO > a.size()) {
+    size_t position = 0;
+    for (int id : a) {
+      position = gallop(b.data(), b.size(), position, id);
+      if (position == b.size() || b[position] != id) {
+        out.push_back(id);
+      }
+    }
+    return;
+  }
+  std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+                      std::back_inserter(out));
+}
+
+// ==================== COHORT QUERIES ====================
+
+std::vector<int> CourseIndex::query(const CohortQuery &query,
+                                    const std::vector<int> &everyone) {
+  std::vector<int> result, scratch;
+
+  if (!query.allOf.empty()) {
+    // Intersect shortest first, so every step is bounded by the result
+    std::vector<const std::vector<int> *> required;
+    for (const std::string &course : query.allOf) {
+      const std::vector<int> *ids = find(course);
+      if (ids == nullptr) {
+        return result; // Nobody took this course
+      }
+      required.push_back(ids);
+    }
+    std::sort(required.begin(), required.end(),
+              [](const std::vector<int> *a, const std::vector<int> *b) {
+                return a->size() < b->size();
+              });
+    result = *required[0];
+    for (size_t i = 1; i < required.size() && !result.empty(); ++i) {
+      intersect(result, *required[i], scratch);
+      result.swap(scratch);
+    }
+  }
+
+  if (!query.anyOf.empty()) {
+    // Without required courses, the union of the lists; otherwise the
+    // union of the result's intersections with them
+    std::vector<int> any, part;
+    for (const std::string &course : query.anyOf) {
+      const std::vector<int> *ids = find(course);
+      if (ids == nullptr) {
+        continue;
+      }
+      if (query.allOf.empty()) {
+        unite(any, *ids, scratch);
+      } else {
+        intersect(result, *ids, part);
+        unite(any, part, scratch);
+      }
+      any.swap(scratch);
+    }
+    result.swap(any);
+  } else if (query.allOf.empty()) {
+    result = everyone;
+  }
+
+  for (const std::string &course : query.noneOf) {
+    const std::vector<int> *ids = find(course);
+    if (ids != nullptr && !result.empty()) {
+      subtract(result, *ids, scratch);
+      result.swap(scratch);
+    }
+  }
+  return result;
+}
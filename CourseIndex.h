@@ -0,0 +1,92 @@
+/**
+ * CourseIndex.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Course enrolment index for cohort queries such as "took Data Structures
+ * and Algorithms but not Operating Systems". Each course keeps a posting
+ * list: the sorted IDs of its students.
+ *
+ * Adding a student in increasing ID order (as loads of sorted files do)
+ * appends to the list. Other changes are collected and merged into the list
+ * the next time it is queried, so random-order loads cost O(k log k) per
+ * course instead of O(k) per insert.
+ *
+ * Queries combine lists smallest first. Two lists of similar length are
+ * intersected by a block merge that compares four IDs of each list at once
+ * (SSE2 where available); a list much longer than the other is searched by
+ * galloping (exponential then binary search), so the cost follows the
+ * shorter list.
+ */
+
+#ifndef COURSEINDEX_H
+#define COURSEINDEX_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Students who took every course in allOf, at least one course in anyOf
+// (when it is not empty) and none of noneOf
+struct CohortQuery {
+  std::vector<std::string> allOf;
+  std::vector<std::string> anyOf;
+  std::vector<std::string> noneOf;
+};
+
+class CourseIndex {
+private:
+  struct PostingList {
+    std::vector<int> ids;     // Sorted, as of the last settle
+    std::vector<int> added;   // Since then, in any order
+    std::vector<int> removed; // Since then, in any order
+  };
+
+  std::unordered_map<std::string, PostingList> lists;
+
+  static void settle(PostingList &list);
+  const std::vector<int> *find(const std::string &course);
+
+public:
+  // A list this many times longer than the other is galloped through
+  static const size_t GALLOP_RATIO = 32;
+
+  /**
+   * Record that a student added/dropped a course
+   * Time Complexity: O(1) amortized (plus the settle on the next query)
+   */
+  void add(std::string_view course, int studentID);
+  void remove(std::string_view course, int studentID);
+
+  void clear() { lists.clear(); }
+
+  /**
+   * Sorted IDs of the students taking a course (empty if none)
+   * Time Complexity: O(1), or O(k log k) if the list changed out of order
+   */
+  const std::vector<int> &students(const std::string &course);
+
+  /**
+   * Evaluate a cohort query. everyone (all student IDs, sorted) is only
+   * used when the query has neither allOf nor anyOf courses.
+   * Time Complexity: about O(s log(l/s)) per list for the smallest list s
+   * and longer list l, O(s + l) when they are of similar length
+   * @return Matching student IDs in increasing order
+   */
+  std::vector<int> query(const CohortQuery &query,
+                         const std::vector<int> &everyone);
+
+  /**
+   * Set operations on sorted lists of distinct IDs (out is replaced)
+   */
+  static void intersect(const std::vector<int> &a, const std::vector<int> &b,
+                        std::vector<int> &out);
+  static void unite(const std::vector<int> &a, const std::vector<int> &b,
+                    std::vector<int> &out);
+  static void subtract(const std::vector<int> &a, const std::vector<int> &b,
+                       std::vector<int> &out);
+};
+
+#endif // COURSEINDEX_H
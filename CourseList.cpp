@@ -0,0 +1,183 @@
+/**
+ * CourseList.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the per-student course container. The hash index uses
+ * linear probing with backward-shift deletion, so no tombstones accumulate.
+ */
+
+#include "CourseList.h"
+#include <utility>
+
+static const size_t NO_SLOT = static_cast<size_t>(-1);
+
+// FNV-1a hash of the course name
+uint32_t CourseList::hashName(std::string_view courseName) {
+  uint32_t h = 2166136261u;
+  for (unsigned char c : courseName) {
+    h ^= c;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+// Locate the index slot holding courseName, or NO_SLOT
+size_t CourseList::findSlot(std::string_view courseName) const {
+  size_t mask = slots.size() - 1;
+  size_t i = hashName(courseName) & mask;
+  while (slots[i] != 0) {
+    if (records[slots[i] - 1].courseName == courseName) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return NO_SLOT;
+}
+
+void CourseList::insertSlot(uint32_t position) {
+  size_t mask = slots.size() - 1;
+  size_t i = hashName(records[position].courseName.view()) & mask;
+  while (slots[i] != 0) {
+    i = (i + 1) & mask;
+  }
+  slots[i] = position + 1;
+}
+
+// Empty a slot and pull later entries of the probe run back into the hole
+void CourseList::eraseSlot(size_t hole) {
+  size_t mask = slots.size() - 1;
+  size_t i = hole;
+  for (;;) {
+    i = (i + 1) & mask;
+    if (slots[i] == 0) {
+      break;
+    }
+    size_t home = hashName(records[slots[i] - 1].courseName.view()) & mask;
+    // Entry may only move if its home slot is not cyclically in (hole, i]
+    bool stays = (hole < i) ? (home > hole && home <= i)
+                            : (home > hole || home <= i);
+    if (!stays) {
+      slots[hole] = slots[i];
+      hole = i;
+    }
+  }
+  slots[hole] = 0;
+}
+
+// Size the table to a power of two at most 1/4 full and re-index all records
+void CourseList::rebuildIndex() {
+  size_t capacity = 16;
+  while (capacity < records.size() * 4) {
+    capacity *= 2;
+  }
+  slots.assign(capacity, 0);
+  for (size_t i = 0; i < records.size(); ++i) {
+    insertSlot(static_cast<uint32_t>(i));
+  }
+}
+
+int CourseList::find(std::string_view courseName) const {
+  if (slots.empty()) {
+    for (size_t i = 0; i < records.size(); ++i) {
+      if (records[i].courseName == courseName) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+  size_t slot = findSlot(courseName);
+  return slot == NO_SLOT ? -1 : static_cast<int>(slots[slot] - 1);
+}
+
+bool CourseList::contains(std::string_view courseName) const {
+  return find(courseName) >= 0;
+}
+
+bool CourseList::add(std::string_view courseName, float grade) {
+  if (contains(courseName)) {
+    return false;
+  }
+  records.emplace_back(courseName, grade);
+  indexAppended();
+  return true;
+}
+
+bool CourseList::add(std::string &&courseName, float grade) {
+  if (contains(courseName)) {
+    return false;
+  }
+  records.emplace_back(std::move(courseName), grade);
+  indexAppended();
+  return true;
+}
+
+// Bring the index up to date after a record was appended
+void CourseList::indexAppended() {
+  if (slots.empty()) {
+    if (records.size() > LINEAR_SCAN_LIMIT) {
+      rebuildIndex();
+    }
+  } else if (records.size() * 2 > slots.size()) {
+    rebuildIndex();
+  } else {
+    insertSlot(static_cast<uint32_t>(records.size() - 1));
+  }
+}
+
+bool CourseList::update(std::string_view courseName, float newGrade) {
+  int pos = find(courseName);
+  if (pos < 0) {
+    return false;
+  }
+  records[pos].grade = newGrade;
+  return true;
+}
+
+bool CourseList::erase(std::string_view courseName) {
+  size_t pos;
+
+  if (slots.empty()) {
+    int found = find(courseName);
+    if (found < 0) {
+      return false;
+    }
+    pos = static_cast<size_t>(found);
+  } else {
+    size_t slot = findSlot(courseName);
+    if (slot == NO_SLOT) {
+      return false;
+    }
+    pos = slots[slot] - 1;
+    eraseSlot(slot);
+  }
+
+  // Move the last record into the gap instead of shifting the tail
+  size_t last = records.size() - 1;
+  if (pos != last) {
+    if (!slots.empty()) {
+      slots[findSlot(records[last].courseName.view())] =
+          static_cast<uint32_t>(pos + 1);
+    }
+    records[pos] = std::move(records[last]);
+  }
+  records.pop_back();
+
+  // Drop the index once the list is short again (with hysteresis)
+  if (!slots.empty() && records.size() <= LINEAR_SCAN_LIMIT / 2) {
+    slots.clear();
+  }
+  return true;
+}
+
+size_t CourseList::heapBytes() const {
+  size_t bytes = slots.capacity() * sizeof(uint32_t);
+  if (records.onHeap()) {
+    bytes += records.capacity() * sizeof(CourseRecord);
+  }
+  for (const CourseRecord &record : records) {
+    bytes += record.courseName.heapBytes();
+  }
+  return bytes;
+}
@@ -0,0 +1,105 @@
+/**
+ * CourseList.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Defines the CourseList class - the per-student course container.
+ * Short course lists are searched linearly; once a student has more than
+ * LINEAR_SCAN_LIMIT courses an open-addressing hash index is built so that
+ * lookups, updates and deletions stay O(1) for long transcripts.
+ *
+ * Records and names are stored inline (SmallVector / ShortString), so a
+ * typical course load of up to INLINE_COURSES needs no heap allocation.
+ */
+
+#ifndef COURSELIST_H
+#define COURSELIST_H
+
+#include "ShortString.h"
+#include "SmallVector.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Structure to hold course information
+struct CourseRecord {
+  ShortString courseName;
+  float grade;
+
+  CourseRecord(std::string_view name, float g) : courseName(name), grade(g) {}
+  CourseRecord(std::string &&name, float g)
+      : courseName(std::move(name)), grade(g) {}
+};
+
+class CourseList {
+private:
+  static const size_t INLINE_COURSES = 6;
+
+  SmallVector<CourseRecord, INLINE_COURSES> records;
+
+  // Open-addressing table of (record position + 1); 0 marks an empty slot.
+  // Only populated when records.size() > LINEAR_SCAN_LIMIT.
+  std::vector<uint32_t> slots;
+
+  static const size_t LINEAR_SCAN_LIMIT = 8;
+
+  static uint32_t hashName(std::string_view courseName);
+  size_t findSlot(std::string_view courseName) const;
+  void indexAppended();
+  void insertSlot(uint32_t position);
+  void eraseSlot(size_t slot);
+  void rebuildIndex();
+
+public:
+  typedef const CourseRecord *const_iterator;
+
+  CourseList() {}
+
+  /**
+   * Find the position of a course
+   * Time Complexity: O(1) expected
+   * @return Index into the list, or -1 if the course is not present
+   */
+  int find(std::string_view courseName) const;
+
+  bool contains(std::string_view courseName) const;
+
+  /**
+   * Add a course if it is not already present
+   * The rvalue overload moves the name in and leaves it untouched on failure.
+   * Time Complexity: O(1) amortized
+   * @return true if added, false if the course already exists
+   */
+  bool add(std::string_view courseName, float grade);
+  bool add(std::string &&courseName, float grade);
+
+  /**
+   * Set the grade of an existing course
+   * @return true if the course was found
+   */
+  bool update(std::string_view courseName, float newGrade);
+
+  /**
+   * Remove a course by swapping the last record into its place
+   * Time Complexity: O(1) expected (does not shift the list)
+   * @return true if the course was found and removed
+   */
+  bool erase(std::string_view courseName);
+
+  /**
+   * Heap memory held beyond sizeof(CourseList) (spilled records, long
+   * course names and the hash index)
+   * Time Complexity: O(m)
+   */
+  size_t heapBytes() const;
+
+  size_t size() const { return records.size(); }
+  bool empty() const { return records.empty(); }
+  const CourseRecord &operator[](size_t i) const { return records[i]; }
+  const CourseRecord &back() const { return records[records.size() - 1]; }
+  const_iterator begin() const { return records.begin(); }
+  const_iterator end() const { return records.end(); }
+};
+
+#endif // COURSELIST_H
@@ -0,0 +1,324 @@
+/**
+ * ExternalSort.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the run files and the k-way merge.
+ */
+
+#include "ExternalSort.h"
+#include "Varint.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <utility>
+
+namespace {
+
+bool rowLess(const SortRow &a, const SortRow &b) {
+  if (a.studentID != b.studentID) {
+    return a.studentID < b.studentID;
+  }
+  return a.sequence < b.sequence;
+}
+
+// Memory charged for a row held in the current run
+size_t rowBytes(const SortRow &row) {
+  return sizeof(SortRow) + row.name.capacity() + row.course.capacity();
+}
+
+void encodeRow(std::string &out, const SortRow &row) {
+  putVarint(out, zigzag(row.studentID));
+  putString(out, row.name);
+  putString(out, row.course);
+  uint32_t bits;
+  std::memcpy(&bits, &row.grade, sizeof(bits));
+  putVarint(out, bits);
+}
+
+bool readVarint(std::istream &in, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = in.get();
+    if (byte == EOF) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool readString(std::istream &in, std::string &text) {
+  uint64_t length;
+  if (!readVarint(in, length)) {
+    return false;
+  }
+  text.resize(length);
+  in.read(&text[0], static_cast<std::streamsize>(length));
+  return static_cast<bool>(in);
+}
+
+// Run file being written, with its own buffer
+struct RunWriter {
+  std::vector<char> buffer;
+  std::ofstream file;
+  std::string encoded;
+
+  explicit RunWriter(const std::string &filename)
+      : buffer(ExternalSorter::MERGE_BUFFER_BYTES) {
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  }
+
+  void write(const SortRow &row) {
+    encoded.clear();
+    encodeRow(encoded, row);
+    file.write(encoded.data(), static_cast<std::streamsize>(encoded.size()));
+  }
+
+  bool close() {
+    file.close();
+    return !file.fail();
+  }
+};
+
+} // namespace
+
+// Run file being merged; head is its smallest row not taken yet
+struct ExternalSorter::RunReader {
+  std::vector<char> buffer;
+  std::ifstream file;
+  SortRow head;
+  size_t order; // Position of the run in input order
+
+  RunReader(const std::string &filename, size_t runOrder)
+      : buffer(MERGE_BUFFER_BYTES), order(runOrder) {
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    file.open(filename, std::ios::in | std::ios::binary);
+    head.sequence = 0;
+  }
+
+  // Read the next row into head (false at the end of the run or if the
+  // file is damaged)
+  bool advance(bool &damaged) {
+    if (file.peek() == EOF) {
+      return false;
+    }
+    uint64_t id, bits;
+    if (!readVarint(file, id) || !readString(file, head.name) ||
+        !readString(file, head.course) || !readVarint(file, bits)) {
+      damaged = true;
+      return false;
+    }
+    head.studentID = static_cast<int>(unzigzag(id));
+    uint32_t word = static_cast<uint32_t>(bits);
+    std::memcpy(&head.grade, &word, sizeof(head.grade));
+    return true;
+  }
+};
+
+// k-way merge of consecutive runs; ties go to the earlier run
+struct ExternalSorter::Merge {
+  std::vector<std::unique_ptr<RunReader>> readers;
+  std::vector<RunReader *> heap; // Readers with rows left, smallest first
+  bool damaged = false;
+
+  static bool later(const RunReader *a, const RunReader *b) {
+    if (a->head.studentID != b->head.studentID) {
+      return a->head.studentID > b->head.studentID;
+    }
+    return a->order > b->order;
+  }
+
+  bool open(const std::vector<std::string> &runs, size_t first,
+            size_t count) {
+    for (size_t i = first; i < first + count; ++i) {
+      readers.push_back(std::make_unique<RunReader>(runs[i], i));
+      RunReader *reader = readers.back().get();
+      if (!reader->file.is_open()) {
+        return false;
+      }
+      if (reader->advance(damaged)) {
+        heap.push_back(reader);
+        std::push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+    return !damaged;
+  }
+
+  bool next(SortRow &row) {
+    if (damaged || heap.empty()) {
+      return false;
+    }
+    std::pop_heap(heap.begin(), heap.end(), later);
+    RunReader *reader = heap.back();
+    row = std::move(reader->head);
+    if (reader->advance(damaged)) {
+      std::push_heap(heap.begin(), heap.end(), later);
+    } else {
+      heap.pop_back();
+    }
+    return true;
+  }
+};
+
+ExternalSorter::ExternalSorter(const std::string &tempPrefix,
+                               size_t memoryLimitBytes)
+    : prefix(tempPrefix), limit(memoryLimitBytes), runBytes(0), runNumber(0),
+      position(0), runsWritten(0), passes(0) {}
+
+ExternalSorter::~ExternalSorter() {
+  output.reset(); // Close the files before removing them
+  for (const std::string &run : runs) {
+    std::remove(run.c_str());
+  }
+}
+
+bool ExternalSorter::fail(const std::string &message) {
+  if (errorMessage.empty()) {
+    errorMessage = message;
+  }
+  return false;
+}
+
+std::string ExternalSorter::nextRunName() {
+  return prefix + "." + std::to_string(runNumber++);
+}
+
+size_t ExternalSorter::fanIn() const {
+  size_t buffers = limit / MERGE_BUFFER_BYTES; // One is for the output
+  size_t runsAtOnce = buffers > 3 ? buffers - 1 : 2;
+  return runsAtOnce < MAX_FAN_IN ? runsAtOnce : MAX_FAN_IN;
+}
+
+// ==================== RUN FORMATION ====================
+
+bool ExternalSorter::add(int studentID, std::string &&name,
+                         std::string &&course, float grade) {
+  if (rows.capacity() == 0) {
+    // Every row is charged at least sizeof(SortRow), so a run never
+    // outgrows this (pages are only touched as rows are added)
+    rows.reserve(std::max(size_t(1), limit / sizeof(SortRow)));
+  }
+
+  SortRow row{studentID, grade, 0, std::move(name), std::move(course)};
+  size_t bytes = rowBytes(row);
+  if (!rows.empty() &&
+      (runBytes + bytes > limit || rows.size() == rows.capacity()) &&
+      !spill()) {
+    return false;
+  }
+  row.sequence = rows.size();
+  runBytes += bytes;
+  rows.push_back(std::move(row));
+  return true;
+}
+
+// Sort the current run and write it out
+bool ExternalSorter::spill() {
+  std::sort(rows.begin(), rows.end(), rowLess);
+  std::string filename = nextRunName();
+  runs.push_back(filename); // Removed by the destructor even if it fails
+  RunWriter writer(filename);
+  for (const SortRow &row : rows) {
+    writer.write(row);
+  }
+  if (!writer.close()) {
+    return fail("could not write run file '" + filename + "'");
+  }
+  runsWritten++;
+  rows.clear(); // Keeps the capacity for the next run
+  runBytes = 0;
+  return true;
+}
+
+// ==================== MERGING ====================
+
+// Merge runs[first, first + count) into a new run file
+bool ExternalSorter::mergeRuns(size_t first, size_t count,
+                               const std::string &filename) {
+  Merge merge;
+  if (!merge.open(runs, first, count)) {
+    return fail("could not read run file");
+  }
+  RunWriter writer(filename);
+  SortRow row;
+  while (merge.next(row)) {
+    writer.write(row);
+  }
+  if (!writer.close() || merge.damaged) {
+    std::remove(filename.c_str());
+    return fail(merge.damaged ? "damaged run file"
+                              : "could not write run file '" + filename +
+                                    "'");
+  }
+  merge.readers.clear(); // Close the inputs before removing them
+  for (size_t i = first; i < first + count; ++i) {
+    std::remove(runs[i].c_str());
+  }
+  return true;
+}
+
+bool ExternalSorter::sort() {
+  if (runs.empty()) {
+    // Everything fit in memory
+    std::sort(rows.begin(), rows.end(), rowLess);
+    position = 0;
+    return true;
+  }
+  if (!rows.empty() && !spill()) {
+    return false;
+  }
+  std::vector<SortRow>().swap(rows); // Free the run buffer for the merge
+
+  size_t k = fanIn();
+  while (runs.size() > k) {
+    std::vector<std::string> merged;
+    for (size_t first = 0; first < runs.size(); first += k) {
+      size_t count = std::min(k, runs.size() - first);
+      if (count == 1) {
+        merged.push_back(runs[first]);
+        continue;
+      }
+      std::string filename = nextRunName();
+      if (!mergeRuns(first, count, filename)) {
+        // Leave the remaining files for the destructor to remove
+        merged.insert(merged.end(), runs.begin() + first, runs.end());
+        runs.swap(merged);
+        return false;
+      }
+      merged.push_back(filename);
+    }
+    runs.swap(merged);
+    passes++;
+  }
+
+  output = std::make_unique<Merge>();
+  if (!output->open(runs, 0, runs.size())) {
+    return fail("could not read run file");
+  }
+  passes++;
+  return true;
+}
+
+bool ExternalSorter::next(SortRow &row) {
+  if (output == nullptr) {
+    if (position >= rows.size()) {
+      return false;
+    }
+    row = std::move(rows[position++]);
+    return true;
+  }
+  if (!output->next(row)) {
+    if (output->damaged) {
+      fail("damaged run file");
+    }
+    return false;
+  }
+  return true;
+}
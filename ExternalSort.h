@@ -0,0 +1,116 @@
+/**
+ * ExternalSort.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Bounded-memory sort of grade rows by student ID, for loading CSV files
+ * larger than memory (AVLTree::loadExternal). Rows are collected until they
+ * use about the memory limit, then sorted and written to a run file. At the
+ * end the runs are merged: up to fanIn() runs at a time, in extra passes
+ * if there are more, and the last pass is read back row by row. Rows with
+ * the same student ID come out in input order, so the first row still
+ * decides a student's name and a repeated course keeps its first grade, as
+ * with loadFromFile.
+ *
+ * Run file format ("<prefix>.<n>", deleted once merged):
+ *   per row: student ID (zigzag), name and course (length-prefixed), the
+ *   grade's IEEE bits, all LEB128 varints (see Varint.h)
+ *
+ * If every row fits within the limit, nothing is written to disk.
+ */
+
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One CSV row
+struct SortRow {
+  int studentID;
+  float grade;
+  size_t sequence; // Input order within its run
+  std::string name;
+  std::string course;
+};
+
+class ExternalSorter {
+private:
+  struct RunReader;
+  struct Merge;
+
+  std::string prefix;
+  size_t limit;
+  std::vector<SortRow> rows; // Current run
+  size_t runBytes;           // Memory charged for the current run
+  std::vector<std::string> runs; // Run files in input order
+  int runNumber;
+  std::unique_ptr<Merge> output; // Final merge, or nullptr
+  size_t position;               // Next row if nothing was spilled
+  std::string errorMessage;
+
+  // Statistics
+  uint64_t runsWritten;
+  int passes;
+
+  bool spill();
+  bool mergeRuns(size_t first, size_t count, const std::string &file);
+  std::string nextRunName();
+  bool fail(const std::string &message);
+
+public:
+  // Read/write buffer of each run file open during a merge
+  static const size_t MERGE_BUFFER_BYTES = 64 * 1024;
+  static const size_t MAX_FAN_IN = 64;
+
+  /**
+   * Constructor - Run files are named "<tempPrefix>.<n>"
+   */
+  ExternalSorter(const std::string &tempPrefix, size_t memoryLimitBytes);
+
+  /**
+   * Destructor - Removes any run files left behind
+   */
+  ~ExternalSorter();
+
+  ExternalSorter(const ExternalSorter &) = delete;
+  ExternalSorter &operator=(const ExternalSorter &) = delete;
+
+  /**
+   * Add a row, writing out a sorted run when the limit is reached
+   * Time Complexity: O(1) amortized, O(r log r) for a run of r rows
+   * @return false if a run could not be written (see error())
+   */
+  bool add(int studentID, std::string &&name, std::string &&course,
+           float grade);
+
+  /**
+   * Finish adding rows: sort the last run and merge the runs down to one
+   * final pass
+   * Time Complexity: O(n log n) comparisons, O(n log_k r) I/O for r runs
+   * and fan-in k
+   * @return false if a run could not be read or written
+   */
+  bool sort();
+
+  /**
+   * Take the next row in (student ID, input order) order
+   * @return false after the last row or on a read error (see failed())
+   */
+  bool next(SortRow &row);
+
+  /**
+   * Runs merged at once: as many as fit in the limit with one buffer each
+   */
+  size_t fanIn() const;
+
+  bool failed() const { return !errorMessage.empty(); }
+  const std::string &error() const { return errorMessage; }
+  uint64_t runCount() const { return runsWritten; }
+  int mergePasses() const { return passes; }
+};
+
+#endif // EXTERNALSORT_H
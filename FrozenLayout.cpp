@@ -0,0 +1,71 @@
+/**
+ * FrozenLayout.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the Eytzinger search layout.
+ */
+
+#include "FrozenLayout.h"
+#include "AVLNode.h"
+#include "Prefetch.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+const size_t CACHE_LINE = 64;
+const size_t SLOTS_PER_LINE = 8; // sizeof(Slot) == 8
+
+} // namespace
+
+FrozenLayout::FrozenLayout(std::vector<AVLNode *> studentsInOrder)
+    : slots(nullptr), students(std::move(studentsInOrder)),
+      count(students.size()) {
+  // One spare line to align slot 0 to a cache line
+  storage.resize(count + 1 + SLOTS_PER_LINE, Slot{0, 0});
+  size_t misalignment =
+      reinterpret_cast<uintptr_t>(storage.data()) % CACHE_LINE;
+  slots = storage.data() +
+          (misalignment == 0 ? 0 : (CACHE_LINE - misalignment) / sizeof(Slot));
+  fill(0, 1);
+}
+
+// In-order walk of the implicit tree assigns the students in ID order
+size_t FrozenLayout::fill(size_t rank, size_t k) {
+  if (k <= count) {
+    rank = fill(rank, 2 * k);
+    slots[k] = Slot{students[rank]->getStudentID(),
+                    static_cast<uint32_t>(rank)};
+    rank = fill(rank + 1, 2 * k + 1);
+  }
+  return rank;
+}
+
+// Eytzinger slot of the smallest ID >= studentID (0 if there is none)
+size_t FrozenLayout::descend(int studentID) const {
+  size_t k = 1;
+  while (k <= count) {
+    // The 8 slots three levels down share one cache line
+    prefetchRead(slots + std::min(k * SLOTS_PER_LINE, count));
+    k = 2 * k + (slots[k].studentID < studentID);
+  }
+  // Undo the right turns taken after the last left turn
+  while (k & 1) {
+    k >>= 1;
+  }
+  return k >> 1;
+}
+
+size_t FrozenLayout::lowerBound(int studentID) const {
+  size_t k = descend(studentID);
+  return k == 0 ? count : slots[k].rank;
+}
+
+AVLNode *FrozenLayout::find(int studentID) const {
+  size_t k = descend(studentID);
+  if (k == 0 || slots[k].studentID != studentID) {
+    return nullptr;
+  }
+  return students[slots[k].rank];
+}
@@ -0,0 +1,72 @@
+/**
+ * FrozenLayout.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Read-only search layout built by AVLTree::freeze() for query-heavy,
+ * edit-free periods (e.g. grade review week).
+ *
+ * Student IDs are stored in Eytzinger (BFS) order: the implicit complete
+ * binary tree with the children of slot k at 2k and 2k + 1. A search walks
+ * it with no data-dependent branches (k = 2k + (key < id)) and prefetches
+ * the cache line holding the slots three levels below, so the top of the
+ * tree stays cached and deeper misses overlap. Each slot also holds the
+ * student's rank, which indexes a contiguous array of students in ID order
+ * used for results, ranks and range scans.
+ */
+
+#ifndef FROZENLAYOUT_H
+#define FROZENLAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AVLNode;
+
+class FrozenLayout {
+private:
+  struct Slot {
+    int studentID;
+    uint32_t rank; // Position in students
+  };
+
+  std::vector<Slot> storage; // Backing memory for slots
+  Slot *slots;               // slots[1..count], slots + 8k is 64-byte aligned
+  std::vector<AVLNode *> students; // In increasing ID order
+  size_t count;
+
+  size_t fill(size_t rank, size_t k);
+  size_t descend(int studentID) const;
+
+public:
+  /**
+   * Constructor - Lay out students (in increasing ID order)
+   * Time Complexity: O(n)
+   */
+  explicit FrozenLayout(std::vector<AVLNode *> studentsInOrder);
+
+  FrozenLayout(const FrozenLayout &) = delete;
+  FrozenLayout &operator=(const FrozenLayout &) = delete;
+
+  /**
+   * Number of students with an ID smaller than studentID
+   * Time Complexity: O(log n), branch-free
+   */
+  size_t lowerBound(int studentID) const;
+
+  /**
+   * Student with this ID, or nullptr
+   * Time Complexity: O(log n)
+   */
+  AVLNode *find(int studentID) const;
+
+  /**
+   * Student at a rank (0 <= rank < size())
+   */
+  AVLNode *student(size_t rank) const { return students[rank]; }
+
+  size_t size() const { return count; }
+};
+
+#endif // FROZENLAYOUT_H
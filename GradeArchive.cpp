@@ -0,0 +1,287 @@
+/**
+ * GradeArchive.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the compact archive writer and streaming reader.
+ */
+
+#include "GradeArchive.h"
+#include "Metrics.h"
+#include "RecordPager.h"
+#include "Varint.h"
+#include <array>
+#include <cmath>
+
+namespace {
+
+const char MAGIC[] = {'P', 'S', '5', 'G', 'C', 'A'};
+const uint64_t FORMAT_VERSION = 1;
+const uint64_t MAX_PAYLOAD = 64u * 1024 * 1024;
+
+std::array<uint32_t, 256> buildCrcTable() {
+  std::array<uint32_t, 256> table;
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t c = i;
+    for (int k = 0; k < 8; ++k) {
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    }
+    table[i] = c;
+  }
+  return table;
+}
+
+// CRC-32 (IEEE 802.3, reflected); the table is built once, thread-safely
+uint32_t crc32(const std::string &data) {
+  static const std::array<uint32_t, 256> table = buildCrcTable();
+
+  uint32_t crc = 0xFFFFFFFFu;
+  for (unsigned char byte : data) {
+    crc = table[(crc ^ byte) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFu;
+}
+
+// Decode a varint straight from a stream
+bool readVarint(std::istream &in, uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = in.get();
+    if (byte == std::char_traits<char>::eof()) {
+      return false;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+// ==================== WRITER ====================
+
+GradeArchiveWriter::GradeArchiveWriter(std::ostream &o)
+    : out(o), blockStudents(0), firstID(0), previousID(0), invalidGrades(0) {
+  std::string header(MAGIC, sizeof(MAGIC));
+  putVarint(header, FORMAT_VERSION);
+  out.write(header.data(), header.size());
+}
+
+void GradeArchiveWriter::add(const AVLNode &student) {
+  int id = student.getStudentID();
+  if (blockStudents == 0) {
+    firstID = id;
+    previousID = id;
+  }
+
+  putVarint(payload, static_cast<uint64_t>(id - previousID));
+  previousID = id;
+  putString(payload, student.getName());
+
+  const CourseList &courses = student.getCourses();
+  putVarint(payload, courses.size());
+  for (const auto &course : courses) {
+    std::string name = course.courseName.str();
+    auto it = dictionary.find(name);
+    if (it != dictionary.end()) {
+      putVarint(payload, it->second + 1);
+    } else {
+      putVarint(payload, 0);
+      putString(payload, name);
+      uint32_t index = static_cast<uint32_t>(dictionary.size());
+      dictionary.emplace(std::move(name), index);
+    }
+    // Also false for NaN; the course keeps its place with a grade of 0
+    bool valid = course.grade >= 0 && course.grade <= 100;
+    invalidGrades += valid ? 0 : 1;
+    putVarint(payload, static_cast<uint64_t>(
+                           valid ? std::lround(course.grade * 100) : 0));
+  }
+
+  if (++blockStudents == BLOCK_STUDENTS) {
+    flushBlock();
+  }
+}
+
+void GradeArchiveWriter::flushBlock() {
+  if (blockStudents == 0) {
+    return;
+  }
+
+  std::string header;
+  putVarint(header, blockStudents);
+  putVarint(header, zigzag(firstID));
+  putVarint(header, payload.size());
+  uint32_t crc = crc32(payload);
+  for (int i = 0; i < 4; ++i) {
+    header += static_cast<char>((crc >> (8 * i)) & 0xFF);
+  }
+
+  out.write(header.data(), header.size());
+  out.write(payload.data(), payload.size());
+
+  payload.clear();
+  dictionary.clear();
+  blockStudents = 0;
+}
+
+bool GradeArchiveWriter::finish() {
+  flushBlock();
+  out.put(0); // End marker: a block of zero students
+  out.flush();
+  return out.good() && invalidGrades == 0;
+}
+
+// ==================== READER ====================
+
+GradeArchiveReader::GradeArchiveReader(std::istream &i)
+    : in(i), position(0), remainingInBlock(0), previousID(0), atEnd(false) {
+  char magic[sizeof(MAGIC)];
+  uint64_t version;
+  if (!in.read(magic, sizeof(magic)) ||
+      std::string(magic, sizeof(magic)) != std::string(MAGIC, sizeof(MAGIC))) {
+    fail("not a grade archive");
+  } else if (!readVarint(in, version) || version != FORMAT_VERSION) {
+    fail("unsupported archive version");
+  }
+}
+
+bool GradeArchiveReader::fail(const std::string &message) {
+  errorMessage = message;
+  atEnd = true;
+  return false;
+}
+
+// Load and verify the next block; sets atEnd at the end marker
+bool GradeArchiveReader::readBlock() {
+  uint64_t count, first, length;
+  if (!readVarint(in, count)) {
+    return fail("archive is truncated");
+  }
+  if (count == 0) {
+    atEnd = true;
+    return false;
+  }
+  if (!readVarint(in, first) || !readVarint(in, length) ||
+      length > MAX_PAYLOAD) {
+    return fail("damaged block header");
+  }
+
+  unsigned char crcBytes[4];
+  if (!in.read(reinterpret_cast<char *>(crcBytes), 4)) {
+    return fail("archive is truncated");
+  }
+  uint32_t expected = crcBytes[0] | (crcBytes[1] << 8) | (crcBytes[2] << 16) |
+                      (static_cast<uint32_t>(crcBytes[3]) << 24);
+
+  payload.resize(length);
+  if (!in.read(&payload[0], static_cast<std::streamsize>(length))) {
+    return fail("archive is truncated");
+  }
+  if (crc32(payload) != expected) {
+    return fail("block checksum mismatch");
+  }
+
+  position = 0;
+  remainingInBlock = static_cast<int>(count);
+  previousID = static_cast<int>(unzigzag(first));
+  dictionary.clear();
+  return true;
+}
+
+bool GradeArchiveReader::next(ArchivedStudent &student) {
+  if (atEnd) {
+    return false;
+  }
+  if (remainingInBlock == 0 && !readBlock()) {
+    return false;
+  }
+
+  uint64_t delta, courseCount;
+  if (!getVarint(payload, position, delta) ||
+      !getString(payload, position, student.name) ||
+      !getVarint(payload, position, courseCount)) {
+    return fail("damaged student record");
+  }
+  student.studentID = previousID + static_cast<int>(delta);
+  previousID = student.studentID;
+
+  student.courses.clear();
+  for (uint64_t i = 0; i < courseCount; ++i) {
+    uint64_t ref, hundredths;
+    std::string name;
+    if (!getVarint(payload, position, ref)) {
+      return fail("damaged course record");
+    }
+    if (ref == 0) {
+      if (!getString(payload, position, name)) {
+        return fail("damaged course record");
+      }
+      dictionary.push_back(name);
+    } else if (ref <= dictionary.size()) {
+      name = dictionary[ref - 1];
+    } else {
+      return fail("unknown course reference");
+    }
+    if (!getVarint(payload, position, hundredths)) {
+      return fail("damaged course record");
+    }
+    student.courses.emplace_back(std::move(name), hundredths / 100.0f);
+  }
+
+  remainingInBlock--;
+  return true;
+}
+
+// ==================== TREE INTEGRATION ====================
+
+bool isArchiveFilename(const std::string &filename) {
+  return filename.size() > 4 &&
+         filename.compare(filename.size() - 4, 4, ".gca") == 0;
+}
+
+bool writeArchive(const AVLTree &tree, std::ostream &out,
+                  std::atomic<int> *studentsWritten) {
+  const RecordPager *pager = tree.recordPager();
+  uint64_t failures = pager != nullptr ? pager->pageInFailures() : 0;
+  GradeArchiveWriter writer(out);
+  tree.forEachStudent([&](const AVLNode &student) {
+    writer.add(student);
+    if (studentsWritten != nullptr) {
+      studentsWritten->fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+  // A record that could not be paged in was written without its courses
+  return writer.finish() &&
+         (pager == nullptr || pager->pageInFailures() == failures);
+}
+
+int loadArchive(AVLTree &tree, std::istream &in, std::string &error) {
+  GradeArchiveReader reader(in);
+  ArchivedStudent student;
+  int count = 0;
+  uint64_t parseNanos = 0, insertNanos = 0;
+
+  uint64_t started = PS5_CLOCK();
+  while (reader.next(student)) {
+    uint64_t parsed = PS5_CLOCK();
+    for (auto &course : student.courses) {
+      tree.insert(student.studentID, student.name, course.first, course.second);
+      count++;
+    }
+    uint64_t inserted = PS5_CLOCK();
+    parseNanos += parsed - started;
+    insertNanos += inserted - parsed;
+    started = inserted;
+  }
+  PS5_PHASE(LOAD_PARSE, parseNanos, count);
+  PS5_PHASE(LOAD_INSERT, insertNanos, count);
+
+  if (reader.failed()) {
+    error = reader.error();
+    return -1;
+  }
+  return count;
+}
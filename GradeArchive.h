@@ -0,0 +1,130 @@
+/**
+ * GradeArchive.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Compact archival format for end-of-term exports (".gca" files).
+ *
+ * Layout (all integers are LEB128 varints unless noted):
+ *   header  "PS5GCA" magic, format version
+ *   block*  studentCount, firstID (zigzag), payloadLength,
+ *           CRC-32 of payload (4 bytes, little endian), payload
+ *   end     a block header with studentCount 0
+ *
+ * Each payload holds up to BLOCK_STUDENTS students in increasing ID order:
+ *   idDelta (from the previous ID, 0 for the first), nameLength, name,
+ *   courseCount, then per course: courseRef, grade in hundredths (0 to
+ *   10000; grades outside 0-100 or NaN cannot be archived).
+ * courseRef 0 introduces a new course name (length + bytes) and adds it to
+ * the block's dictionary; courseRef k refers to dictionary entry k - 1.
+ * GPA is not stored; it is recomputed on load.
+ *
+ * Blocks are self-contained, so readers stream one block at a time.
+ */
+
+#ifndef GRADEARCHIVE_H
+#define GRADEARCHIVE_H
+
+#include "AVLTree.h"
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// One decoded student record
+struct ArchivedStudent {
+  int studentID;
+  std::string name;
+  std::vector<std::pair<std::string, float>> courses;
+};
+
+class GradeArchiveWriter {
+private:
+  std::ostream &out;
+  std::string payload;
+  std::unordered_map<std::string, uint32_t> dictionary;
+  int blockStudents;
+  int firstID;
+  int previousID;
+  int invalidGrades; // Grades that could not be stored
+
+  void flushBlock();
+
+public:
+  static const int BLOCK_STUDENTS = 1024;
+
+  /**
+   * Constructor - Writes the archive header to out
+   */
+  explicit GradeArchiveWriter(std::ostream &out);
+
+  /**
+   * Append a student; students must be added in increasing ID order
+   */
+  void add(const AVLNode &student);
+
+  /**
+   * Write the last block and the end marker
+   * @return true if everything was written successfully; false if a student
+   *         had a grade outside 0-100 (see invalidGradeCount)
+   */
+  bool finish();
+
+  int invalidGradeCount() const { return invalidGrades; }
+};
+
+class GradeArchiveReader {
+private:
+  std::istream &in;
+  std::string payload;
+  size_t position;
+  int remainingInBlock;
+  int previousID;
+  std::vector<std::string> dictionary;
+  bool atEnd;
+  std::string errorMessage;
+
+  bool readBlock();
+  bool fail(const std::string &message);
+
+public:
+  /**
+   * Constructor - Reads and checks the archive header
+   */
+  explicit GradeArchiveReader(std::istream &in);
+
+  /**
+   * Decode the next student, reading a new block when needed
+   * @return false at the end of the archive or on corruption (see error())
+   */
+  bool next(ArchivedStudent &student);
+
+  bool failed() const { return !errorMessage.empty(); }
+  const std::string &error() const { return errorMessage; }
+};
+
+/**
+ * True if filename has the archive extension ".gca"
+ */
+bool isArchiveFilename(const std::string &filename);
+
+/**
+ * Write the whole tree to an archive stream without printing
+ * @param studentsWritten If given, incremented after each student
+ * @return true on success
+ */
+bool writeArchive(const AVLTree &tree, std::ostream &out,
+                  std::atomic<int> *studentsWritten = nullptr);
+
+/**
+ * Load every student from an archive into the tree
+ * @return Number of course records loaded, or -1 if the archive is damaged
+ *         (students decoded before the damage are kept)
+ */
+int loadArchive(AVLTree &tree, std::istream &in, std::string &error);
+
+#endif // GRADEARCHIVE_H
@@ -0,0 +1,228 @@
+/**
+ * GradingScale.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of grading scales and the current grading policy.
+ */
+
+#include "GradingScale.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+
+struct BuiltInBand {
+  const char *letter;
+  float minimum;
+  float points;
+};
+
+const BuiltInBand STANDARD_BANDS[] = {
+    {"A", 90, 4.0f}, {"B", 80, 3.0f}, {"C", 70, 2.0f},
+    {"D", 60, 1.0f}, {"F", 0, 0.0f}};
+
+const BuiltInBand PLUS_MINUS_BANDS[] = {
+    {"A", 93, 4.0f},  {"A-", 90, 3.7f}, {"B+", 87, 3.3f}, {"B", 83, 3.0f},
+    {"B-", 80, 2.7f}, {"C+", 77, 2.3f}, {"C", 73, 2.0f},  {"C-", 70, 1.7f},
+    {"D+", 67, 1.3f}, {"D", 63, 1.0f},  {"D-", 60, 0.7f}, {"F", 0, 0.0f}};
+
+template <size_t N>
+std::vector<GradeBand> toBands(const BuiltInBand (&builtIn)[N]) {
+  std::vector<GradeBand> bands;
+  for (const BuiltInBand &band : builtIn) {
+    bands.push_back({band.letter, band.minimum, band.points});
+  }
+  return bands;
+}
+
+std::string trim(const std::string &text) {
+  size_t first = text.find_first_not_of(" \t\r");
+  if (first == std::string::npos) {
+    return "";
+  }
+  size_t last = text.find_last_not_of(" \t\r");
+  return text.substr(first, last - first + 1);
+}
+
+GradingPolicy currentPolicy;
+
+} // namespace
+
+// ==================== GRADING SCALE ====================
+
+GradingScale::GradingScale() {
+  std::string error;
+  compile(toBands(STANDARD_BANDS), error);
+}
+
+bool GradingScale::builtIn(std::string_view name, GradingScale &scale) {
+  std::string error;
+  if (name == "standard") {
+    return scale.compile(toBands(STANDARD_BANDS), error);
+  }
+  if (name == "plusminus") {
+    return scale.compile(toBands(PLUS_MINUS_BANDS), error);
+  }
+  return false;
+}
+
+size_t GradingScale::hundredths(float grade) {
+  if (!(grade > 0)) {
+    return 0; // Also NaN
+  }
+  if (grade >= 100) {
+    return TABLE_SIZE - 1;
+  }
+  return static_cast<size_t>(std::lround(static_cast<double>(grade) * 100));
+}
+
+bool GradingScale::compile(std::vector<GradeBand> newBands,
+                           std::string &error) {
+  if (newBands.empty() || newBands.size() > 255) {
+    error = "a scale needs 1 to 255 bands";
+    return false;
+  }
+  for (const GradeBand &band : newBands) {
+    if (band.letter.empty() || band.letter.find(',') != std::string::npos) {
+      error = "band letters must be non-empty and contain no commas";
+      return false;
+    }
+    if (!(band.minimum >= 0 && band.minimum <= 100)) {
+      error = "band minimums must be between 0 and 100";
+      return false;
+    }
+    if (!(band.points >= 0 && std::isfinite(band.points))) {
+      error = "band points must be zero or more";
+      return false;
+    }
+  }
+
+  std::sort(newBands.begin(), newBands.end(),
+            [](const GradeBand &a, const GradeBand &b) {
+              return a.minimum > b.minimum;
+            });
+  for (size_t i = 1; i < newBands.size(); ++i) {
+    if (hundredths(newBands[i].minimum) ==
+        hundredths(newBands[i - 1].minimum)) {
+      error = "two bands have the same minimum";
+      return false;
+    }
+  }
+  if (hundredths(newBands.back().minimum) != 0) {
+    error = "the lowest band must start at 0";
+    return false;
+  }
+
+  // Fill each band's range of the table, lowest band first
+  std::vector<uint8_t> newTable(TABLE_SIZE);
+  size_t start = 0;
+  for (size_t i = newBands.size(); i-- > 0;) {
+    size_t end = i > 0 ? hundredths(newBands[i - 1].minimum) : TABLE_SIZE;
+    std::fill(newTable.begin() + start, newTable.begin() + end,
+              static_cast<uint8_t>(i));
+    start = end;
+  }
+
+  bands.swap(newBands);
+  table.swap(newTable);
+  return true;
+}
+
+// ==================== GRADING POLICY ====================
+
+void GradingPolicy::setCourseScale(const std::string &courseName,
+                                   const GradingScale &scale) {
+  courseScales[courseName] = scale;
+}
+
+bool GradingPolicy::loadFromFile(const std::string &filename,
+                                 std::string &error) {
+  std::ifstream file(filename);
+  if (!file.is_open()) {
+    error = "cannot open '" + filename + "'";
+    return false;
+  }
+
+  GradingPolicy policy;
+  std::string section;             // Course name, empty for the default
+  std::vector<GradeBand> bands;
+  int sectionLine = 0;
+
+  // Compile the bands read for the current section
+  auto finishSection = [&]() {
+    if (section.empty() && bands.empty()) {
+      return true; // Keep the standard default scale
+    }
+    GradingScale scale;
+    std::string problem;
+    if (!scale.compile(bands, problem)) {
+      error = "scale at line " + std::to_string(sectionLine) + ": " + problem;
+      return false;
+    }
+    if (section.empty()) {
+      policy.setDefaultScale(scale);
+    } else {
+      policy.setCourseScale(section, scale);
+    }
+    return true;
+  };
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    line = trim(line);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    if (line[0] == '[') {
+      if (line.back() != ']' || trim(line.substr(1, line.size() - 2)).empty()) {
+        error = "line " + std::to_string(lineNumber) + ": bad course section";
+        return false;
+      }
+      if (!finishSection()) {
+        return false;
+      }
+      section = trim(line.substr(1, line.size() - 2));
+      bands.clear();
+      sectionLine = lineNumber;
+      continue;
+    }
+
+    size_t first = line.find(',');
+    size_t second =
+        first == std::string::npos ? first : line.find(',', first + 1);
+    GradeBand band;
+    bool parsed = second != std::string::npos;
+    if (parsed) {
+      try {
+        band.letter = trim(line.substr(0, first));
+        band.minimum = std::stof(line.substr(first + 1, second - first - 1));
+        band.points = std::stof(line.substr(second + 1));
+      } catch (const std::exception &e) {
+        parsed = false;
+      }
+    }
+    if (!parsed) {
+      error = "line " + std::to_string(lineNumber) +
+              ": expected letter,minimum,points";
+      return false;
+    }
+    if (bands.empty() && section.empty()) {
+      sectionLine = lineNumber;
+    }
+    bands.push_back(band);
+  }
+  if (!finishSection()) {
+    return false;
+  }
+
+  *this = policy;
+  return true;
+}
+
+const GradingPolicy &gradingPolicy() { return currentPolicy; }
+
+void setGradingPolicy(const GradingPolicy &policy) { currentPolicy = policy; }
@@ -0,0 +1,135 @@
+/**
+ * GradingScale.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Grading policy: how a numeric grade (0-100) maps to a letter and to grade
+ * points for the GPA. A GradingScale is a list of bands ("A- from 90, 3.7
+ * points") compiled into a lookup table indexed by the grade in hundredths,
+ * so a lookup is one rounding and two array reads instead of a chain of
+ * float compares. Grades are rounded to hundredths first, the precision the
+ * CSV and archive formats keep.
+ *
+ * A GradingPolicy has a default scale and optional per-course scales. The
+ * current policy is used for GPA calculation (AVLNode), display and the GPA
+ * written on export. Built-in scales are "standard" (A/B/C/D/F at
+ * 90/80/70/60, the original behavior) and "plusminus"; others are read
+ * from a policy file:
+ *
+ *   # letter,minimum,points  (the lowest band must start at 0)
+ *   A,90,4.0
+ *   B,80,3.0
+ *   ...
+ *   [CSC 307]                 (bands for one course follow)
+ *   A,85,4.0
+ *   ...
+ */
+
+#ifndef GRADINGSCALE_H
+#define GRADINGSCALE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Grades >= minimum (up to the next band) earn letter and points
+struct GradeBand {
+  std::string letter;
+  float minimum;
+  float points;
+};
+
+class GradingScale {
+private:
+  std::vector<GradeBand> bands; // Highest minimum first
+  std::vector<uint8_t> table;   // Band for each grade in hundredths
+
+  static size_t hundredths(float grade);
+
+public:
+  static const size_t TABLE_SIZE = 10001; // 0.00 to 100.00
+
+  /**
+   * Constructor - The standard A/B/C/D/F scale
+   */
+  GradingScale();
+
+  /**
+   * Built-in scale by name ("standard" or "plusminus")
+   * @return false if there is no such scale
+   */
+  static bool builtIn(std::string_view name, GradingScale &scale);
+
+  /**
+   * Replace the bands (in any order) and rebuild the lookup table
+   * Time Complexity: O(TABLE_SIZE + b log b) for b bands
+   * @return false (scale unchanged) if the bands are invalid
+   */
+  bool compile(std::vector<GradeBand> newBands, std::string &error);
+
+  /**
+   * Band of a grade (below 0 counts as 0, above 100 as 100)
+   * Time Complexity: O(1)
+   */
+  const GradeBand &band(float grade) const {
+    return bands[table[hundredths(grade)]];
+  }
+
+  float points(float grade) const { return band(grade).points; }
+  const std::string &letter(float grade) const { return band(grade).letter; }
+  const std::vector<GradeBand> &getBands() const { return bands; }
+};
+
+class GradingPolicy {
+private:
+  GradingScale defaultScale;
+  std::map<std::string, GradingScale, std::less<>> courseScales;
+
+public:
+  /**
+   * Scale used for a course (the default unless the course has its own)
+   * Time Complexity: O(1) without per-course scales, else O(log c)
+   */
+  const GradingScale &scaleFor(std::string_view courseName) const {
+    if (courseScales.empty()) {
+      return defaultScale;
+    }
+    auto it = courseScales.find(courseName);
+    return it != courseScales.end() ? it->second : defaultScale;
+  }
+
+  float points(std::string_view courseName, float grade) const {
+    return scaleFor(courseName).points(grade);
+  }
+
+  const std::string &letter(std::string_view courseName, float grade) const {
+    return scaleFor(courseName).letter(grade);
+  }
+
+  void setDefaultScale(const GradingScale &scale) { defaultScale = scale; }
+  void setCourseScale(const std::string &courseName,
+                      const GradingScale &scale);
+
+  /**
+   * Read a policy file (format above); bands before the first [course]
+   * section form the default scale (standard if there are none)
+   * @return false with a message naming the line if the file is invalid
+   */
+  bool loadFromFile(const std::string &filename, std::string &error);
+};
+
+/**
+ * The policy in effect (the standard scale until setGradingPolicy)
+ */
+const GradingPolicy &gradingPolicy();
+
+/**
+ * Switch policies. Stored GPAs keep their old values until recomputed
+ * (AVLTree::regradeAll). Call only while no other thread uses a tree.
+ */
+void setGradingPolicy(const GradingPolicy &policy);
+
+#endif // GRADINGSCALE_H
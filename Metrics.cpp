@@ -0,0 +1,228 @@
+/**
+ * Metrics.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the latency histograms and trace recorder.
+ */
+
+#include "Metrics.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Values below 16 ns get a bucket each; above that, four buckets per power
+// of two up to 2^63 ns.
+const int LINEAR_BUCKETS = 16;
+const int SUB_BUCKETS = 4;
+const int BUCKET_COUNT = LINEAR_BUCKETS + (64 - 4) * SUB_BUCKETS;
+
+const char *const OPERATION_NAMES[Metrics::OPERATION_COUNT] = {
+    "insert",        "search",       "searchMany", "updateCourse",
+    "deleteStudent", "loadFromFile", "saveToFile"};
+
+const char *const PHASE_NAMES[Metrics::PHASE_COUNT] = {
+    "load.parse", "load.sort", "load.insert", "save.write", "save.rename"};
+
+struct Histogram {
+  std::atomic<uint64_t> buckets[BUCKET_COUNT];
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> total;
+  std::atomic<uint64_t> max;
+
+  Histogram() { clear(); }
+
+  void clear() {
+    for (auto &b : buckets) {
+      b.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    total.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+  }
+};
+
+struct PhaseTotal {
+  std::atomic<uint64_t> nanos{0};
+  std::atomic<uint64_t> calls{0};
+};
+
+struct Span {
+  const char *name;
+  uint64_t start;
+  uint64_t end;
+  size_t thread;
+};
+
+Histogram histograms[Metrics::OPERATION_COUNT];
+PhaseTotal phases[Metrics::PHASE_COUNT];
+std::atomic<uint64_t> rotations{0};
+
+std::mutex traceMutex;
+bool tracing = false;
+uint64_t traceStart = 0;
+std::vector<Span> spans;
+
+int bucketIndex(uint64_t nanos) {
+  if (nanos < LINEAR_BUCKETS) {
+    return static_cast<int>(nanos);
+  }
+  int msb = 63 - __builtin_clzll(nanos);
+  int sub = static_cast<int>((nanos >> (msb - 2)) & (SUB_BUCKETS - 1));
+  return LINEAR_BUCKETS + (msb - 4) * SUB_BUCKETS + sub;
+}
+
+// Largest value that falls in a bucket, used as the reported percentile
+uint64_t bucketLimit(int index) {
+  if (index < LINEAR_BUCKETS) {
+    return static_cast<uint64_t>(index);
+  }
+  int msb = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 4;
+  uint64_t sub = static_cast<uint64_t>((index - LINEAR_BUCKETS) % SUB_BUCKETS);
+  uint64_t step = 1ull << (msb - 2);
+  return (1ull << msb) + (sub + 1) * step - 1;
+}
+
+// Reported values never exceed the recorded maximum
+uint64_t percentile(const Histogram &h, uint64_t count, double p) {
+  uint64_t max = h.max.load(std::memory_order_relaxed);
+  uint64_t target = static_cast<uint64_t>(p * count);
+  if (target >= count) {
+    target = count - 1;
+  }
+  uint64_t seen = 0;
+  for (int i = 0; i < BUCKET_COUNT; ++i) {
+    seen += h.buckets[i].load(std::memory_order_relaxed);
+    if (seen > target) {
+      return std::min(bucketLimit(i), max);
+    }
+  }
+  return max;
+}
+
+} // namespace
+
+void Metrics::record(Operation op, uint64_t nanos) {
+  Histogram &h = histograms[op];
+  h.buckets[bucketIndex(nanos)].fetch_add(1, std::memory_order_relaxed);
+  h.count.fetch_add(1, std::memory_order_relaxed);
+  h.total.fetch_add(nanos, std::memory_order_relaxed);
+
+  uint64_t previous = h.max.load(std::memory_order_relaxed);
+  while (nanos > previous &&
+         !h.max.compare_exchange_weak(previous, nanos,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+void Metrics::addPhase(Phase phase, uint64_t nanos, uint64_t calls) {
+  phases[phase].nanos.fetch_add(nanos, std::memory_order_relaxed);
+  phases[phase].calls.fetch_add(calls, std::memory_order_relaxed);
+}
+
+void Metrics::countRotation() {
+  rotations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::span(const char *name, uint64_t startNanos, uint64_t endNanos) {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  if (tracing) {
+    size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+    spans.push_back({name, startNanos, endNanos, thread % 100000});
+  }
+}
+
+void Metrics::startTrace() {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  tracing = true;
+  traceStart = now();
+  spans.clear();
+}
+
+bool Metrics::writeTrace(const std::string &filename) {
+  std::lock_guard<std::mutex> lock(traceMutex);
+  std::ofstream out(filename);
+  if (!out) {
+    return false;
+  }
+
+  // Chrome trace event format; timestamps are microseconds
+  out << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+  for (size_t i = 0; i < spans.size(); ++i) {
+    const Span &s = spans[i];
+    out << (i == 0 ? "\n" : ",\n") << "{\"name\":\"" << s.name
+        << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << s.thread
+        << ",\"ts\":" << (s.start - traceStart) / 1000.0
+        << ",\"dur\":" << (s.end - s.start) / 1000.0 << "}";
+  }
+  out << "\n]}\n";
+  return static_cast<bool>(out);
+}
+
+void Metrics::dump(std::ostream &out) {
+  out << "\n--- Operation Latency (microseconds) ---\n";
+  out << std::left << std::setw(15) << "Operation" << std::right
+      << std::setw(9) << "Count" << std::setw(11) << "Mean" << std::setw(11)
+      << "p50" << std::setw(11) << "p99" << std::setw(11) << "p999"
+      << std::setw(11) << "Max" << "\n";
+  out << std::string(79, '-') << "\n";
+
+  std::ios::fmtflags flags = out.flags();
+  std::streamsize precision = out.precision();
+  out << std::fixed << std::setprecision(2);
+  bool any = false;
+  for (int op = 0; op < OPERATION_COUNT; ++op) {
+    const Histogram &h = histograms[op];
+    uint64_t count = h.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      continue;
+    }
+    any = true;
+    double mean = h.total.load(std::memory_order_relaxed) / 1000.0 / count;
+    out << std::left << std::setw(15) << OPERATION_NAMES[op] << std::right
+        << std::setw(9) << count << std::setw(11) << mean << std::setw(11)
+        << percentile(h, count, 0.50) / 1000.0 << std::setw(11)
+        << percentile(h, count, 0.99) / 1000.0 << std::setw(11)
+        << percentile(h, count, 0.999) / 1000.0 << std::setw(11)
+        << h.max.load(std::memory_order_relaxed) / 1000.0 << "\n";
+  }
+  if (!any) {
+    out << "(no operations recorded)\n";
+  }
+
+  out << "\n--- Load/Save Phases ---\n";
+  for (int p = 0; p < PHASE_COUNT; ++p) {
+    uint64_t calls = phases[p].calls.load(std::memory_order_relaxed);
+    if (calls > 0) {
+      out << std::left << std::setw(15) << PHASE_NAMES[p] << std::right
+          << std::setw(12)
+          << phases[p].nanos.load(std::memory_order_relaxed) / 1e6
+          << " ms over " << calls << " calls\n";
+    }
+  }
+  out << std::left << std::setw(15) << "rebalance" << std::right
+      << std::setw(12) << rotations.load(std::memory_order_relaxed)
+      << " rotations\n";
+  out.flags(flags);
+  out.precision(precision);
+}
+
+void Metrics::reset() {
+  for (auto &h : histograms) {
+    h.clear();
+  }
+  for (auto &p : phases) {
+    p.nanos.store(0, std::memory_order_relaxed);
+    p.calls.store(0, std::memory_order_relaxed);
+  }
+  rotations.store(0, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(traceMutex);
+  spans.clear();
+}
@@ -0,0 +1,129 @@
+/**
+ * Metrics.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Low-overhead latency instrumentation. Every timed AVLTree operation is
+ * recorded in a log-bucketed histogram (four buckets per power of two, so
+ * percentiles are accurate to about 20%). Load and save phases are summed
+ * separately, and whole loads/saves can also be written as trace spans in
+ * Chrome trace format (open in chrome://tracing or Perfetto).
+ *
+ * Building with -DPS5_NO_METRICS (make METRICS=0) compiles all
+ * instrumentation macros to nothing.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+class Metrics {
+public:
+  enum Operation {
+    INSERT,
+    SEARCH,
+    SEARCH_MANY,
+    UPDATE_COURSE,
+    DELETE_STUDENT,
+    LOAD_FILE,
+    SAVE_FILE,
+    OPERATION_COUNT
+  };
+
+  enum Phase {
+    LOAD_PARSE,
+    LOAD_SORT,
+    LOAD_INSERT,
+    SAVE_WRITE,
+    SAVE_RENAME,
+    PHASE_COUNT
+  };
+
+  typedef std::chrono::steady_clock Clock;
+
+  static uint64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               Clock::now().time_since_epoch())
+        .count();
+  }
+
+  /**
+   * Record one operation latency in nanoseconds (thread-safe)
+   */
+  static void record(Operation op, uint64_t nanos);
+
+  /**
+   * Add time spent in a load/save phase (thread-safe)
+   */
+  static void addPhase(Phase phase, uint64_t nanos, uint64_t calls = 1);
+
+  /**
+   * Count one AVL rotation (rebalancing work)
+   */
+  static void countRotation();
+
+  /**
+   * Record a trace span if tracing is on (see startTrace)
+   */
+  static void span(const char *name, uint64_t startNanos, uint64_t endNanos);
+
+  /**
+   * Start collecting trace spans; they are written by writeTrace()
+   */
+  static void startTrace();
+  static bool writeTrace(const std::string &filename);
+
+  /**
+   * Print a p50/p99/p999/max table for every operation seen so far
+   */
+  static void dump(std::ostream &out);
+
+  /**
+   * Forget everything recorded so far
+   */
+  static void reset();
+};
+
+// Times the enclosing scope as one operation
+class OpTimer {
+private:
+  Metrics::Operation op;
+  uint64_t start;
+
+public:
+  explicit OpTimer(Metrics::Operation o) : op(o), start(Metrics::now()) {}
+  ~OpTimer() { Metrics::record(op, Metrics::now() - start); }
+};
+
+// Times the enclosing scope as a named trace span
+class TraceSpan {
+private:
+  const char *name;
+  uint64_t start;
+
+public:
+  explicit TraceSpan(const char *n) : name(n), start(Metrics::now()) {}
+  ~TraceSpan() { Metrics::span(name, start, Metrics::now()); }
+};
+
+#ifndef PS5_NO_METRICS
+#define PS5_TIME_OP(op) OpTimer ps5OpTimer(Metrics::op)
+#define PS5_TRACE_SPAN(name) TraceSpan ps5TraceSpan(name)
+#define PS5_PHASE(phase, nanos, calls)                                         \
+  Metrics::addPhase(Metrics::phase, nanos, calls)
+#define PS5_COUNT_ROTATION() Metrics::countRotation()
+#define PS5_CLOCK() Metrics::now()
+#else
+#define PS5_TIME_OP(op) ((void)0)
+#define PS5_TRACE_SPAN(name) ((void)0)
+#define PS5_PHASE(phase, nanos, calls) ((void)(nanos), (void)(calls))
+#define PS5_COUNT_ROTATION() ((void)0)
+#define PS5_CLOCK() uint64_t(0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,193 @@
+/**
+ * NameIndex.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the name prefix and fuzzy search index.
+ */
+
+#include "NameIndex.h"
+#include <algorithm>
+#include <climits>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+// Smallest string greater than every string starting with prefix
+// (empty if there is none)
+std::string prefixEnd(std::string prefix) {
+  while (!prefix.empty()) {
+    unsigned char last = static_cast<unsigned char>(prefix.back());
+    if (last != 0xFF) {
+      prefix.back() = static_cast<char>(last + 1);
+      return prefix;
+    }
+    prefix.pop_back();
+  }
+  return prefix;
+}
+
+size_t countWords(std::string_view text) {
+  return text.empty() ? 0 : std::count(text.begin(), text.end(), ' ') + 1;
+}
+
+} // namespace
+
+std::string NameIndex::fold(std::string_view name) {
+  std::string folded;
+  folded.reserve(name.size());
+  for (char c : name) {
+    if (c == ' ' || c == '\t') {
+      if (!folded.empty() && folded.back() != ' ') {
+        folded += ' ';
+      }
+    } else if (c >= 'A' && c <= 'Z') {
+      folded += static_cast<char>(c - 'A' + 'a');
+    } else {
+      folded += c;
+    }
+  }
+  if (!folded.empty() && folded.back() == ' ') {
+    folded.pop_back();
+  }
+  return folded;
+}
+
+// Call visit(key) for the folded name and every suffix starting at a word
+template <typename Visit>
+void NameIndex::forEachKey(std::string_view name, int studentID,
+                           Visit visit) {
+  std::string folded = fold(name);
+  for (size_t start = 0; start < folded.size();) {
+    visit(std::make_pair(folded.substr(start), studentID));
+    size_t space = folded.find(' ', start);
+    if (space == std::string::npos) {
+      break;
+    }
+    start = space + 1;
+  }
+}
+
+void NameIndex::add(std::string_view name, int studentID) {
+  forEachKey(name, studentID,
+             [&](std::pair<std::string, int> &&key) { keys.insert(key); });
+}
+
+void NameIndex::remove(std::string_view name, int studentID) {
+  forEachKey(name, studentID,
+             [&](std::pair<std::string, int> &&key) { keys.erase(key); });
+}
+
+std::vector<int> NameIndex::prefix(std::string_view prefix,
+                                   size_t limit) const {
+  std::string folded = fold(prefix);
+  std::vector<int> ids;
+  std::unordered_set<int> seen;
+
+  for (auto it = keys.lower_bound(std::make_pair(folded, INT_MIN));
+       it != keys.end() && ids.size() < limit &&
+       it->first.compare(0, folded.size(), folded) == 0;
+       ++it) {
+    if (seen.insert(it->second).second) {
+      ids.push_back(it->second);
+    }
+  }
+  return ids;
+}
+
+std::vector<NameMatch> NameIndex::fuzzy(std::string_view name,
+                                        int maxDistance, size_t limit) const {
+  std::string query = fold(name);
+  size_t m = query.size();
+  size_t queryWords = countWords(query);
+
+  // rows[d] is the DP row for the first d characters of the current key:
+  // rows[d][j] = edit distance between key[0, d) and query[0, j)
+  std::vector<std::vector<int>> rows(1, std::vector<int>(m + 1));
+  for (size_t j = 0; j <= m; ++j) {
+    rows[0][j] = static_cast<int>(j);
+  }
+  std::string rowsKey; // Key prefix the rows currently describe
+
+  std::vector<NameMatch> matches;
+  std::unordered_map<int, size_t> position; // Student -> index in matches
+
+  auto it = keys.begin();
+  while (it != keys.end()) {
+    const std::string &key = it->first;
+
+    // Compare only as many words of the key as the query has
+    size_t stop = key.size();
+    size_t space = 0;
+    for (size_t w = 0; w < queryWords; ++w) {
+      space = key.find(' ', w == 0 ? 0 : space + 1);
+      if (space == std::string::npos) {
+        break;
+      }
+      if (w + 1 == queryWords) {
+        stop = space;
+      }
+    }
+
+    // Rows shared with the previous key are still valid
+    size_t depth = 0;
+    size_t shared = std::min(rowsKey.size(), stop);
+    while (depth < shared && rowsKey[depth] == key[depth]) {
+      depth++;
+    }
+    rowsKey.resize(depth);
+
+    bool pruned = false;
+    while (depth < stop) {
+      if (rows.size() <= depth + 1) {
+        rows.emplace_back(m + 1);
+      }
+      const std::vector<int> &above = rows[depth];
+      std::vector<int> &row = rows[depth + 1];
+      row[0] = static_cast<int>(depth + 1);
+      int best = row[0];
+      for (size_t j = 1; j <= m; ++j) {
+        int substitute = above[j - 1] + (key[depth] == query[j - 1] ? 0 : 1);
+        row[j] = std::min({above[j] + 1, row[j - 1] + 1, substitute});
+        best = std::min(best, row[j]);
+      }
+      rowsKey += key[depth];
+      depth++;
+      if (best > maxDistance) {
+        pruned = true;
+        break;
+      }
+    }
+
+    if (pruned) {
+      // No key below this prefix can come within maxDistance
+      std::string end = prefixEnd(rowsKey);
+      it = end.empty() ? keys.end()
+                       : keys.lower_bound(std::make_pair(end, INT_MIN));
+      continue;
+    }
+
+    int distance = rows[stop][m];
+    if (distance <= maxDistance) {
+      auto found = position.find(it->second);
+      if (found == position.end()) {
+        position.emplace(it->second, matches.size());
+        matches.push_back({it->second, distance});
+      } else if (distance < matches[found->second].distance) {
+        matches[found->second].distance = distance;
+      }
+    }
+    ++it;
+  }
+
+  // Closest first; ties keep key order
+  std::stable_sort(matches.begin(), matches.end(),
+                   [](const NameMatch &a, const NameMatch &b) {
+                     return a.distance < b.distance;
+                   });
+  if (matches.size() > limit) {
+    matches.resize(limit);
+  }
+  return matches;
+}
@@ -0,0 +1,69 @@
+/**
+ * NameIndex.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Sorted table of case-folded student names for lookups by name. Every
+ * word of a name starts a key ("Jane van Dyke" is stored as "jane van dyke",
+ * "van dyke" and "dyke"), so a prefix of any word finds the student.
+ *
+ * Prefix search is a range scan of the sorted keys. Fuzzy search computes
+ * the edit distance (Levenshtein) of the query against the keys in sorted
+ * order, reusing the dynamic-programming rows of the prefix a key shares with
+ * the previous one and skipping every key below a prefix that is already too
+ * far away, like walking a trie.
+ */
+
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+struct NameMatch {
+  int studentID;
+  int distance; // Edit distance to the closest key of the student (0 = exact)
+};
+
+class NameIndex {
+private:
+  std::set<std::pair<std::string, int>> keys; // (folded key, student ID)
+
+  template <typename Visit>
+  void forEachKey(std::string_view name, int studentID, Visit visit);
+
+public:
+  /**
+   * Lowercase ASCII letters and collapse runs of spaces
+   */
+  static std::string fold(std::string_view name);
+
+  /**
+   * Add/remove all keys of a student's name
+   * Time Complexity: O(w log n) for w words in the name
+   */
+  void add(std::string_view name, int studentID);
+  void remove(std::string_view name, int studentID);
+
+  void clear() { keys.clear(); }
+
+  /**
+   * IDs of students with a name word starting with prefix, in key order,
+   * each reported once
+   * Time Complexity: O(log n + k)
+   */
+  std::vector<int> prefix(std::string_view prefix, size_t limit) const;
+
+  /**
+   * Students whose name (or a name suffix starting at a word) is within
+   * maxDistance edits of name, closest first
+   */
+  std::vector<NameMatch> fuzzy(std::string_view name, int maxDistance,
+                               size_t limit) const;
+};
+
+#endif // NAMEINDEX_H
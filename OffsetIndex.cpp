@@ -0,0 +1,299 @@
+/**
+ * OffsetIndex.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the sparse CSV offset index and its Bloom filter.
+ */
+
+#include "OffsetIndex.h"
+#include "Varint.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const char MAGIC[] = {'P', 'S', '5', 'O', 'I', 'X'};
+const uint64_t FORMAT_VERSION = 1;
+const int BLOOM_HASHES = 7;
+const size_t BLOOM_BITS_PER_STUDENT = 10; // About 1% false positives
+
+// Student ID at the start of a CSV row
+bool rowStudentID(const std::string &line, int &studentID) {
+  const char *start = line.c_str();
+  char *end;
+  long value = std::strtol(start, &end, 10);
+  if (end == start || *end != ',' || value < INT32_MIN || value > INT32_MAX) {
+    return false;
+  }
+  studentID = static_cast<int>(value);
+  return true;
+}
+
+// 64-bit hash of an ID (splitmix64 finalizer); the Bloom filter derives
+// its probes from the two halves
+uint64_t mixID(int studentID) {
+  uint64_t x = static_cast<uint32_t>(studentID) + 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
+void putWord(std::string &out, uint64_t word) {
+  for (int i = 0; i < 8; ++i) {
+    out += static_cast<char>(word >> (8 * i));
+  }
+}
+
+bool getWord(const std::string &in, size_t &position, uint64_t &word) {
+  if (in.size() - position < 8) {
+    return false;
+  }
+  word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word |= static_cast<uint64_t>(static_cast<unsigned char>(in[position++]))
+            << (8 * i);
+  }
+  return true;
+}
+
+} // namespace
+
+OffsetIndex::OffsetIndex()
+    : bloomHashes(BLOOM_HASHES), students(0), fileSize(0), fileTime(0) {}
+
+std::string OffsetIndex::sidecarName(const std::string &csvFile) {
+  return csvFile + ".idx";
+}
+
+bool OffsetIndex::fileIdentity(const std::string &filename, uint64_t &size,
+                               int64_t &time) {
+  std::error_code error;
+  size = std::filesystem::file_size(filename, error);
+  if (error) {
+    return false;
+  }
+  auto modified = std::filesystem::last_write_time(filename, error);
+  if (error) {
+    return false;
+  }
+  time = modified.time_since_epoch().count();
+  return true;
+}
+
+bool OffsetIndex::open(const std::string &csvFile, bool &rebuilt) {
+  rebuilt = false;
+  std::string indexFile = sidecarName(csvFile);
+  if (read(indexFile, csvFile)) {
+    return true;
+  }
+  if (!build(csvFile)) {
+    return false;
+  }
+  rebuilt = true;
+  write(indexFile); // Only a cache: a failed write costs a rescan next time
+  return true;
+}
+
+bool OffsetIndex::build(const std::string &csvFile) {
+  blocks.clear();
+  if (!fileIdentity(csvFile, fileSize, fileTime)) {
+    return false;
+  }
+  std::ifstream file(csvFile, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  std::string line;
+  std::getline(file, line); // Header
+  uint64_t position = std::min<uint64_t>(line.size() + 1, fileSize);
+
+  std::vector<int> studentIDs;
+  Block current{0, 0, position, 0};
+  bool hasID = false;
+
+  while (std::getline(file, line)) {
+    uint64_t lineStart = position;
+    position = std::min<uint64_t>(position + line.size() + 1, fileSize);
+
+    int id;
+    if (!rowStudentID(line, id)) {
+      continue; // Loading the block reports the bad row
+    }
+    if (!hasID) {
+      current.firstID = current.lastID = id;
+      hasID = true;
+      studentIDs.push_back(id);
+      continue;
+    }
+    if (id < current.lastID) {
+      return false; // Not sorted by student ID
+    }
+    if (id == current.lastID) {
+      continue;
+    }
+    studentIDs.push_back(id);
+
+    // Cut only between students, so a student never spans two blocks
+    if (lineStart - current.offset >= BLOCK_BYTES) {
+      current.length = lineStart - current.offset;
+      blocks.push_back(current);
+      current = Block{id, id, lineStart, 0};
+    } else {
+      current.lastID = id;
+    }
+  }
+  if (hasID) {
+    current.length = position - current.offset;
+    blocks.push_back(current);
+  }
+
+  students = studentIDs.size();
+  buildBloom(studentIDs);
+  return true;
+}
+
+void OffsetIndex::buildBloom(const std::vector<int> &studentIDs) {
+  size_t bits = std::max<size_t>(64, studentIDs.size() *
+                                         BLOOM_BITS_PER_STUDENT);
+  bloom.assign((bits + 63) / 64, 0);
+  bloomHashes = BLOOM_HASHES;
+
+  uint64_t totalBits = bloom.size() * 64;
+  for (int id : studentIDs) {
+    uint64_t hash = mixID(id);
+    uint64_t step = (hash >> 32) | 1;
+    for (int i = 0; i < bloomHashes; ++i) {
+      uint64_t bit = (hash + i * step) % totalBits;
+      bloom[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+  }
+}
+
+bool OffsetIndex::mayContain(int studentID) const {
+  uint64_t totalBits = bloom.size() * 64;
+  uint64_t hash = mixID(studentID);
+  uint64_t step = (hash >> 32) | 1;
+  for (int i = 0; i < bloomHashes; ++i) {
+    uint64_t bit = (hash + i * step) % totalBits;
+    if ((bloom[bit / 64] & (uint64_t(1) << (bit % 64))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int OffsetIndex::findBlock(int studentID) const {
+  // Last block starting at or before the student
+  auto it = std::upper_bound(
+      blocks.begin(), blocks.end(), studentID,
+      [](int id, const Block &block) { return id < block.firstID; });
+  if (it == blocks.begin()) {
+    return -1;
+  }
+  --it;
+  return studentID <= it->lastID ? static_cast<int>(it - blocks.begin()) : -1;
+}
+
+bool OffsetIndex::write(const std::string &indexFile) const {
+  std::string out(MAGIC, sizeof(MAGIC));
+  putVarint(out, FORMAT_VERSION);
+  putVarint(out, fileSize);
+  putVarint(out, zigzag(fileTime));
+  putVarint(out, students);
+
+  putVarint(out, blocks.size());
+  putVarint(out, blocks.empty() ? 0 : blocks.front().offset);
+  int64_t previousID = 0;
+  for (const Block &block : blocks) {
+    putVarint(out, zigzag(int64_t(block.firstID) - previousID));
+    putVarint(out, static_cast<uint64_t>(int64_t(block.lastID) -
+                                         block.firstID));
+    putVarint(out, block.length);
+    previousID = block.lastID;
+  }
+
+  putVarint(out, bloomHashes);
+  putVarint(out, bloom.size());
+  for (uint64_t word : bloom) {
+    putWord(out, word);
+  }
+
+  // Replace the old index atomically, like saveToFile
+  std::string tempFile = indexFile + ".tmp";
+  std::ofstream file(tempFile, std::ios::out | std::ios::binary);
+  file.write(out.data(), out.size());
+  file.close();
+  if (!file) {
+    std::remove(tempFile.c_str());
+    return false;
+  }
+  return std::rename(tempFile.c_str(), indexFile.c_str()) == 0;
+}
+
+bool OffsetIndex::read(const std::string &indexFile,
+                       const std::string &csvFile) {
+  blocks.clear();
+  uint64_t currentSize;
+  int64_t currentTime;
+  if (!fileIdentity(csvFile, currentSize, currentTime)) {
+    return false;
+  }
+  std::ifstream file(indexFile, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::string in((std::istreambuf_iterator<char>(file)),
+                 std::istreambuf_iterator<char>());
+
+  size_t position = sizeof(MAGIC);
+  uint64_t version, time, count, blockCount, offset;
+  if (in.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0 ||
+      !getVarint(in, position, version) || version != FORMAT_VERSION ||
+      !getVarint(in, position, fileSize) || fileSize != currentSize ||
+      !getVarint(in, position, time) || unzigzag(time) != currentTime ||
+      !getVarint(in, position, count) ||
+      !getVarint(in, position, blockCount) || blockCount > in.size() ||
+      !getVarint(in, position, offset)) {
+    return false;
+  }
+  fileTime = currentTime;
+  students = count;
+
+  blocks.reserve(blockCount);
+  int64_t previousID = 0;
+  for (uint64_t i = 0; i < blockCount; ++i) {
+    uint64_t firstDelta, span, length;
+    if (!getVarint(in, position, firstDelta) ||
+        !getVarint(in, position, span) || !getVarint(in, position, length) ||
+        length > fileSize - offset) {
+      blocks.clear();
+      return false;
+    }
+    int64_t firstID = previousID + unzigzag(firstDelta);
+    int64_t lastID = firstID + static_cast<int64_t>(span);
+    blocks.push_back(Block{static_cast<int>(firstID),
+                           static_cast<int>(lastID), offset, length});
+    offset += length;
+    previousID = lastID;
+  }
+
+  uint64_t hashes, words;
+  if (!getVarint(in, position, hashes) || hashes == 0 || hashes > 16 ||
+      !getVarint(in, position, words) || words == 0 ||
+      words > (in.size() - position) / 8) {
+    blocks.clear();
+    return false;
+  }
+  bloomHashes = static_cast<int>(hashes);
+  bloom.resize(words);
+  for (uint64_t &word : bloom) {
+    getWord(in, position, word);
+  }
+  return true;
+}
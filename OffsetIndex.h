@@ -0,0 +1,104 @@
+/**
+ * OffsetIndex.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Sparse index of a CSV grade file for lazy loading (AVLTree::loadLazily).
+ * The rows after the header are cut into blocks of about BLOCK_BYTES at
+ * student boundaries; each block records the first and last student ID it
+ * holds and its byte range in the file. A Bloom filter over all student IDs
+ * answers most lookups of students that are not in the file without reading
+ * any block.
+ *
+ * The index is kept next to the CSV file as "<file>.idx":
+ *   header  "PS5OIX" magic, format version
+ *   source  file size, modification time (zigzag), student count
+ *   blocks  block count, offset of the first block, then per block:
+ *           firstID (zigzag delta from the previous lastID), lastID - firstID,
+ *           length in bytes (blocks are contiguous)
+ *   bloom   hash count, word count, words (8 bytes each, little endian)
+ * All integers are LEB128 varints (see Varint.h) unless noted. An index
+ * whose size or time does not match the CSV file is rebuilt.
+ *
+ * Only files sorted by student ID (as saveToFile writes them) can be indexed.
+ */
+
+#ifndef OFFSETINDEX_H
+#define OFFSETINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class OffsetIndex {
+public:
+  struct Block {
+    int firstID;
+    int lastID;
+    uint64_t offset; // Byte offset of the block's first row
+    uint64_t length; // Bytes up to the next block
+  };
+
+  static const uint64_t BLOCK_BYTES = 16 * 1024;
+
+private:
+  std::vector<Block> blocks;
+  std::vector<uint64_t> bloom; // Bloom filter bits
+  int bloomHashes;
+  size_t students;
+  uint64_t fileSize;
+  int64_t fileTime;
+
+  static bool fileIdentity(const std::string &filename, uint64_t &size,
+                           int64_t &time);
+  void buildBloom(const std::vector<int> &studentIDs);
+
+public:
+  OffsetIndex();
+
+  /**
+   * Name of the index file kept for a CSV file
+   */
+  static std::string sidecarName(const std::string &csvFile);
+
+  /**
+   * Read the index of a CSV file, or scan the file and write a new index if
+   * it is missing or out of date
+   * Time Complexity: O(index size), or O(file size) when (re)building
+   * @param rebuilt Set to true if the file had to be scanned
+   * @return false if the file cannot be read or is not sorted by student ID
+   */
+  bool open(const std::string &csvFile, bool &rebuilt);
+
+  /**
+   * Scan a CSV file and build its index (without writing it)
+   * Time Complexity: O(file size)
+   */
+  bool build(const std::string &csvFile);
+
+  /**
+   * Read an index file; fails if it does not describe csvFile as it is now
+   */
+  bool read(const std::string &indexFile, const std::string &csvFile);
+
+  bool write(const std::string &indexFile) const;
+
+  /**
+   * False if the student is certainly not in the file (Bloom filter)
+   * Time Complexity: O(1)
+   */
+  bool mayContain(int studentID) const;
+
+  /**
+   * Block whose ID range contains the student, or -1
+   * Time Complexity: O(log b) for b blocks
+   */
+  int findBlock(int studentID) const;
+
+  size_t blockCount() const { return blocks.size(); }
+  const Block &block(size_t i) const { return blocks[i]; }
+  size_t studentCount() const { return students; }
+};
+
+#endif // OFFSETINDEX_H
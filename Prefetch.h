@@ -0,0 +1,21 @@
+/**
+ * Prefetch.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Software prefetch hint used by the batched lookups (AVLTree::searchMany).
+ * Compiles to nothing on compilers without __builtin_prefetch.
+ */
+
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+inline void prefetchRead(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  (void)address;
+#endif
+}
+
+#endif // PREFETCH_H
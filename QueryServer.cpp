@@ -0,0 +1,482 @@
+/**
+ * QueryServer.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the socket query server. The event loop is level
+ * triggered: every readable connection is drained, all complete lines are
+ * executed in order, and the batch of responses is written back at once.
+ * A connection whose responses back up stops being polled for input until
+ * they are written.
+ */
+
+#include "QueryServer.h"
+#include "Metrics.h"
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t MAX_REQUEST_LENGTH = 64 * 1024;
+const int MAX_EVENTS = 64;
+
+bool parseID(std::string_view text, int &id) {
+  const char *end = text.data() + text.size();
+  auto result = std::from_chars(text.data(), end, id);
+  return result.ec == std::errc() && result.ptr == end && id > 0;
+}
+
+bool parseGrade(std::string_view text, float &grade) {
+  const char *end = text.data() + text.size();
+  auto result = std::from_chars(text.data(), end, grade);
+  return result.ec == std::errc() && result.ptr == end && grade >= 0 &&
+         grade <= 100;
+}
+
+void appendFixed(std::string &out, float value) {
+  char buffer[32];
+  int n = std::snprintf(buffer, sizeof(buffer), "%.2f", value);
+  out.append(buffer, n);
+}
+
+#if defined(__linux__)
+
+// Resolve "unix:/path", "tcp:PORT" or "tcp:HOST:PORT" to a socket address
+bool parseAddress(const std::string &address, sockaddr_storage &storage,
+                  socklen_t &length, std::string &unixPath) {
+  std::memset(&storage, 0, sizeof(storage));
+
+  if (address.compare(0, 5, "unix:") == 0) {
+    unixPath = address.substr(5);
+    sockaddr_un *addr = reinterpret_cast<sockaddr_un *>(&storage);
+    if (unixPath.empty() || unixPath.size() >= sizeof(addr->sun_path)) {
+      return false;
+    }
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, unixPath.c_str(), unixPath.size() + 1);
+    length = sizeof(sockaddr_un);
+    return true;
+  }
+
+  if (address.compare(0, 4, "tcp:") == 0) {
+    std::string rest = address.substr(4);
+    std::string host = "127.0.0.1";
+    size_t colon = rest.rfind(':');
+    if (colon != std::string::npos) {
+      host = rest.substr(0, colon);
+      rest = rest.substr(colon + 1);
+    }
+    int port = 0;
+    auto result = std::from_chars(rest.data(), rest.data() + rest.size(), port);
+    if (result.ec != std::errc() || port <= 0 || port > 65535) {
+      return false;
+    }
+    sockaddr_in *addr = reinterpret_cast<sockaddr_in *>(&storage);
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, host.c_str(), &addr->sin_addr) != 1) {
+      return false;
+    }
+    length = sizeof(sockaddr_in);
+    unixPath.clear();
+    return true;
+  }
+
+  return false;
+}
+
+#endif
+
+} // namespace
+
+// ==================== REQUEST EXECUTION ====================
+
+void QueryServer::execute(std::string_view line, std::string &out) {
+  // Split into at most 5 tab-separated fields
+  std::string_view fields[5];
+  size_t count = 0;
+  while (count < 5) {
+    size_t tab = line.find('\t');
+    fields[count++] = line.substr(0, tab);
+    if (tab == std::string_view::npos) {
+      break;
+    }
+    line.remove_prefix(tab + 1);
+  }
+
+  std::string_view command = fields[0];
+  int id = 0;
+  float grade = 0;
+  served++;
+
+  if (command == "PING" && count == 1) {
+    out += "PONG\n";
+  } else if (command == "STATS" && count == 1) {
+    Metrics::dump(std::cout);
+    std::cout.flush();
+    out += "OK\n";
+  } else if (command == "COUNT" && count == 1) {
+    out += "OK\t";
+    out += std::to_string(tree.size());
+    out += '\n';
+  } else if (command == "GET" && count == 2 && parseID(fields[1], id)) {
+    AVLNode *student = tree.search(id);
+    if (student == nullptr) {
+      out += "NOTFOUND\n";
+      return;
+    }
+    out += "OK\t";
+    out += std::to_string(id);
+    out += '\t';
+    out += student->getName();
+    out += '\t';
+    appendFixed(out, student->getGPA());
+    out += '\t';
+    bool first = true;
+    for (const auto &course : student->getCourses()) {
+      if (!first) {
+        out += ';';
+      }
+      first = false;
+      out += course.courseName.view();
+      out += '=';
+      appendFixed(out, course.grade);
+    }
+    out += '\n';
+  } else if (command == "ADD" && count == 5 && parseID(fields[1], id) &&
+             parseGrade(fields[4], grade)) {
+    StudentHandle student = tree.findOrCreate(
+        id, std::string(fields[2]), std::string(fields[3]), grade);
+    if (student.wasCreated() || student.addCourse(fields[3], grade)) {
+      out += "OK\n";
+    } else {
+      out += "EXISTS\n";
+    }
+  } else if (command == "UPDATE" && count == 4 && parseID(fields[1], id) &&
+             parseGrade(fields[3], grade)) {
+    out += tree.updateCourse(id, fields[2], grade) ? "OK\n" : "NOTFOUND\n";
+  } else if (command == "DROP" && count == 3 && parseID(fields[1], id)) {
+    StudentHandle student = tree.lookup(id);
+    if (!student || !student->hasCourse(fields[2])) {
+      out += "NOTFOUND\n";
+    } else if (student->getCourseCount() == 1) {
+      out += "ERR only course; use DEL to remove the student\n";
+    } else {
+      student.deleteCourse(fields[2]);
+      out += "OK\n";
+    }
+  } else if (command == "DEL" && count == 2 && parseID(fields[1], id)) {
+    if (tree.search(id) == nullptr) {
+      out += "NOTFOUND\n";
+    } else {
+      tree.deleteStudent(id);
+      out += "OK\n";
+    }
+  } else if (command == "RANK" && count == 2 && parseID(fields[1], id)) {
+    int position = tree.rank(id);
+    if (position < 0) {
+      out += "NOTFOUND\n";
+    } else {
+      out += "OK\t";
+      out += std::to_string(position);
+      out += '\n';
+    }
+  } else {
+    out += "ERR malformed request\n";
+  }
+}
+
+#if defined(__linux__)
+
+// ==================== EVENT LOOP ====================
+
+QueryServer::QueryServer(AVLTree &t)
+    : tree(t), listenFd(-1), epollFd(-1), stopping(0), served(0) {}
+
+QueryServer::~QueryServer() {
+  for (const auto &entry : connections) {
+    close(entry.first);
+  }
+  if (listenFd >= 0) {
+    close(listenFd);
+  }
+  if (epollFd >= 0) {
+    close(epollFd);
+  }
+  if (!unixPath.empty()) {
+    unlink(unixPath.c_str());
+  }
+}
+
+bool QueryServer::listen(const std::string &address) {
+  sockaddr_storage storage;
+  socklen_t length = 0;
+  std::string path;
+  if (!parseAddress(address, storage, length, path)) {
+    std::cout << "Error: Invalid server address '" << address << "'."
+              << std::endl;
+    return false;
+  }
+
+  listenFd =
+      socket(storage.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd < 0) {
+    std::perror("socket");
+    return false;
+  }
+
+  if (!path.empty()) {
+    unlink(path.c_str()); // Remove a stale socket from an earlier run
+  } else {
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  }
+
+  if (bind(listenFd, reinterpret_cast<sockaddr *>(&storage), length) < 0 ||
+      ::listen(listenFd, SOMAXCONN) < 0) {
+    std::perror("bind/listen");
+    return false;
+  }
+  unixPath = path;
+
+  epollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (epollFd < 0) {
+    std::perror("epoll_create1");
+    return false;
+  }
+
+  epoll_event event;
+  event.events = EPOLLIN;
+  event.data.fd = listenFd;
+  epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+  return true;
+}
+
+void QueryServer::stop() { stopping = 1; }
+
+void QueryServer::run() {
+  epoll_event events[MAX_EVENTS];
+
+  while (!stopping) {
+    int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue; // Interrupted by a signal; re-check stopping
+      }
+      std::perror("epoll_wait");
+      break;
+    }
+
+    for (int i = 0; i < ready; ++i) {
+      int fd = events[i].data.fd;
+      if (fd == listenFd) {
+        acceptClients();
+        continue;
+      }
+
+      auto it = connections.find(fd);
+      if (it == connections.end()) {
+        continue;
+      }
+
+      if (events[i].events & EPOLLIN) {
+        handleReadable(fd, it->second);
+      } else if (events[i].events & EPOLLOUT) {
+        updateConnection(fd, it->second);
+      } else if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+        closeConnection(fd);
+      }
+    }
+  }
+}
+
+void QueryServer::acceptClients() {
+  for (;;) {
+    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return; // EAGAIN: no more pending connections
+    }
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)); // TCP only
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    connections[fd] =
+        Connection{std::string(), std::string(), 0, EPOLLIN, false};
+  }
+}
+
+void QueryServer::handleReadable(int fd, Connection &conn) {
+  char buffer[64 * 1024];
+  conn.out.erase(0, conn.outPos); // Drop what a slow client already read
+  conn.outPos = 0;
+
+  // Stop once enough responses are waiting; the remaining requests stay in
+  // the socket until the client reads them
+  while (!conn.inputClosed &&
+         conn.out.size() - conn.outPos < OUTPUT_HIGH_WATER) {
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n > 0) {
+      conn.in.append(buffer, static_cast<size_t>(n));
+      executeRequests(conn);
+      continue;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+      closeConnection(fd); // Reset: the responses cannot be delivered
+      return;
+    }
+    conn.inputClosed = n == 0; // Half-closed: answer what was sent
+    break;
+  }
+
+  // One write for the whole batch of responses
+  updateConnection(fd, conn);
+}
+
+// Execute every complete (pipelined) request in order
+void QueryServer::executeRequests(Connection &conn) {
+  size_t start = 0;
+  for (;;) {
+    size_t newline = conn.in.find('\n', start);
+    if (newline == std::string::npos) {
+      break;
+    }
+    std::string_view line(conn.in.data() + start, newline - start);
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+    if (!line.empty()) {
+      execute(line, conn.out);
+    }
+    start = newline + 1;
+  }
+  conn.in.erase(0, start);
+
+  if (conn.in.size() > MAX_REQUEST_LENGTH) {
+    conn.out += "ERR request too long\n";
+    conn.in.clear();
+    conn.inputClosed = true;
+  }
+}
+
+// Write pending responses until done or the socket buffer is full
+// @return false if the connection failed
+bool QueryServer::flush(int fd, Connection &conn) {
+  while (conn.outPos < conn.out.size()) {
+    ssize_t n = send(fd, conn.out.data() + conn.outPos,
+                     conn.out.size() - conn.outPos, MSG_NOSIGNAL);
+    if (n > 0) {
+      conn.outPos += static_cast<size_t>(n);
+      continue;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return true;
+    }
+    return false;
+  }
+
+  conn.out.clear();
+  conn.outPos = 0;
+  return true;
+}
+
+// Write what can be written, then close the connection if it is finished or
+// poll for input only below the high-water mark and for output while
+// responses are pending
+void QueryServer::updateConnection(int fd, Connection &conn) {
+  if (!flush(fd, conn)) {
+    closeConnection(fd);
+    return;
+  }
+  size_t pending = conn.out.size() - conn.outPos;
+  if (conn.inputClosed && pending == 0) {
+    closeConnection(fd);
+    return;
+  }
+
+  uint32_t events = 0;
+  if (!conn.inputClosed && pending < OUTPUT_HIGH_WATER) {
+    events |= EPOLLIN;
+  }
+  if (pending > 0) {
+    events |= EPOLLOUT;
+  }
+  if (events != conn.events) {
+    epoll_event event;
+    event.events = events;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    conn.events = events;
+  }
+}
+
+void QueryServer::closeConnection(int fd) {
+  epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  connections.erase(fd);
+}
+
+int connectToServer(const std::string &address) {
+  sockaddr_storage storage;
+  socklen_t length = 0;
+  std::string path;
+  if (!parseAddress(address, storage, length, path)) {
+    return -1;
+  }
+
+  int fd = socket(storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  if (connect(fd, reinterpret_cast<sockaddr *>(&storage), length) < 0) {
+    close(fd);
+    return -1;
+  }
+  if (path.empty()) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  }
+  return fd;
+}
+
+#else // Server mode needs epoll
+
+QueryServer::QueryServer(AVLTree &t)
+    : tree(t), listenFd(-1), epollFd(-1), stopping(0), served(0) {}
+
+QueryServer::~QueryServer() {}
+
+bool QueryServer::listen(const std::string &) {
+  std::cout << "Error: Server mode is only supported on Linux." << std::endl;
+  return false;
+}
+
+void QueryServer::run() {}
+
+void QueryServer::stop() { stopping = 1; }
+
+int connectToServer(const std::string &) { return -1; }
+
+#endif
@@ -0,0 +1,107 @@
+/**
+ * QueryServer.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Defines the QueryServer class - serves lookups and edits against a
+ * resident AVLTree over a Unix domain socket or loopback TCP, using a
+ * single-threaded non-blocking epoll loop (Linux only).
+ *
+ * Protocol: one request per line, fields separated by tabs. Clients may
+ * pipeline any number of requests; responses come back in order and all
+ * responses produced by one read are sent with a single write. While more
+ * than OUTPUT_HIGH_WATER bytes of responses wait for a client that is not
+ * reading them, the server stops reading its requests. A client that
+ * shuts down its sending side still gets every response before the
+ * connection is closed.
+ *
+ *   GET <id>                       OK <id> <name> <gpa> <course>=<grade>;...
+ *   ADD <id> <name> <course> <g>   OK | EXISTS
+ *   UPDATE <id> <course> <g>       OK | NOTFOUND
+ *   DROP <id> <course>             OK | NOTFOUND | ERR ...
+ *   DEL <id>                       OK | NOTFOUND
+ *   RANK <id>                      OK <rank> | NOTFOUND
+ *   COUNT                          OK <students>
+ *   PING                           PONG
+ *   STATS                          OK (latency table printed by the server)
+ *
+ * Malformed requests get "ERR <reason>".
+ */
+
+#ifndef QUERYSERVER_H
+#define QUERYSERVER_H
+
+#include "AVLTree.h"
+#include <csignal>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Default server address used by GradeSystem --serve and GradeLoadGen
+const std::string DEFAULT_SERVER_ADDRESS = "unix:/tmp/gradesystem.sock";
+
+class QueryServer {
+private:
+  struct Connection {
+    std::string in;   // Bytes received but not yet parsed
+    std::string out;  // Responses not yet written
+    size_t outPos;    // Bytes of out already written
+    uint32_t events;  // epoll events the connection is registered for
+    bool inputClosed; // No more requests: close once out is written
+  };
+
+  AVLTree &tree;
+  int listenFd;
+  int epollFd;
+  std::string unixPath; // Socket file to remove on shutdown
+  volatile std::sig_atomic_t stopping;
+  std::unordered_map<int, Connection> connections;
+  unsigned long long served;
+
+  void acceptClients();
+  void handleReadable(int fd, Connection &conn);
+  void executeRequests(Connection &conn);
+  bool flush(int fd, Connection &conn);
+  void updateConnection(int fd, Connection &conn);
+  void closeConnection(int fd);
+  void execute(std::string_view line, std::string &out);
+
+public:
+  // Unwritten response bytes above which a connection's requests are not
+  // read (backpressure)
+  static const size_t OUTPUT_HIGH_WATER = 256 * 1024;
+
+  explicit QueryServer(AVLTree &tree);
+  ~QueryServer();
+
+  QueryServer(const QueryServer &) = delete;
+  QueryServer &operator=(const QueryServer &) = delete;
+
+  /**
+   * Start listening
+   * @param address "unix:/path/to.sock", "tcp:PORT" or "tcp:127.0.0.1:PORT"
+   * @return true if the socket is bound and listening
+   */
+  bool listen(const std::string &address);
+
+  /**
+   * Serve requests until stop() is called
+   */
+  void run();
+
+  /**
+   * Ask run() to return; safe to call from a signal handler
+   */
+  void stop();
+
+  unsigned long long requestsServed() const { return served; }
+};
+
+/**
+ * Open a blocking client connection to a server address
+ * @return Socket file descriptor, or -1 on failure
+ */
+int connectToServer(const std::string &address);
+
+#endif // QUERYSERVER_H
@@ -0,0 +1,204 @@
+/**
+ * RecordPager.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the LRU record cache and its page file.
+ */
+
+#include "RecordPager.h"
+#include "Varint.h"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+RecordPager::RecordPager(const std::string &pageFile, size_t budgetBytes)
+    : path(pageFile), fileEnd(0), budget(budgetBytes), residentBytes(0),
+      residentCount(0), newest(nullptr), oldest(nullptr), users(1),
+      faults(0), pageOuts(0), writes(0), readFailures(0) {
+  file.open(path, std::ios::in | std::ios::out | std::ios::binary |
+                      std::ios::trunc);
+}
+
+RecordPager::~RecordPager() {
+  file.close();
+  std::remove(path.c_str());
+}
+
+RecordPager *RecordPager::create(const std::string &pageFile,
+                                 size_t budgetBytes) {
+  RecordPager *pager = new RecordPager(pageFile, budgetBytes);
+  if (!pager->file.is_open()) {
+    delete pager;
+    return nullptr;
+  }
+  return pager;
+}
+
+void RecordPager::release() {
+  if (--users == 0) {
+    delete this;
+  }
+}
+
+// ==================== LRU LIST ====================
+
+size_t RecordPager::recordBytes(const StudentRecord &record) {
+  return sizeof(StudentRecord) + record.name.heapBytes() +
+         record.courses.heapBytes();
+}
+
+// Insert a record as the newest
+void RecordPager::link(StudentRecord *record) {
+  record->older = newest;
+  record->newer = nullptr;
+  if (newest != nullptr) {
+    newest->newer = record;
+  } else {
+    oldest = record;
+  }
+  newest = record;
+}
+
+void RecordPager::unlink(StudentRecord *record) {
+  (record->newer != nullptr ? record->newer->older : newest) = record->older;
+  (record->older != nullptr ? record->older->newer : oldest) = record->newer;
+  record->newer = record->older = nullptr;
+}
+
+// Add a node's resident record to the list and charge it to the budget
+void RecordPager::admit(const AVLNode *node) {
+  StudentRecord *record = node->record;
+  record->owner = node;
+  record->bytes = recordBytes(*record);
+  residentBytes += record->bytes;
+  residentCount++;
+  link(record);
+}
+
+void RecordPager::evict(StudentRecord *record) {
+  unlink(record);
+  residentBytes -= record->bytes;
+  residentCount--;
+}
+
+void RecordPager::attach(AVLNode *node) {
+  node->pager = this;
+  retain();
+  if (node->record != nullptr) {
+    admit(node);
+  }
+}
+
+void RecordPager::detach(AVLNode *node) {
+  if (node->record != nullptr) {
+    evict(node->record);
+  }
+  node->pager = nullptr;
+  release(); // May delete this pager
+}
+
+void RecordPager::touch(const AVLNode *node) {
+  StudentRecord *record = node->record;
+  if (record != nullptr && record != newest) {
+    unlink(record);
+    link(record);
+  }
+}
+
+void RecordPager::resized(StudentRecord *record) {
+  residentBytes -= record->bytes;
+  record->bytes = recordBytes(*record);
+  residentBytes += record->bytes;
+}
+
+// ==================== PAGING ====================
+
+// Append a record to the page file and remember where it is
+bool RecordPager::writeOut(const AVLNode *node) {
+  const StudentRecord &record = *node->record;
+  std::string out;
+  putString(out, record.name.view());
+  putVarint(out, record.courses.size());
+  for (const CourseRecord &course : record.courses) {
+    putString(out, course.courseName.view());
+    uint32_t bits;
+    std::memcpy(&bits, &course.grade, sizeof(bits));
+    putVarint(out, bits);
+  }
+
+  file.clear();
+  file.seekp(static_cast<std::streamoff>(fileEnd));
+  file.write(out.data(), static_cast<std::streamsize>(out.size()));
+  if (!file) {
+    return false;
+  }
+  node->pageOffset = fileEnd;
+  node->pageLength = static_cast<uint32_t>(out.size());
+  fileEnd += out.size();
+  writes++;
+  return true;
+}
+
+const StudentRecord &RecordPager::pageIn(const AVLNode *node) {
+  std::string in(node->pageLength, '\0');
+  file.clear();
+  file.seekg(static_cast<std::streamoff>(node->pageOffset));
+  file.read(&in[0], static_cast<std::streamsize>(in.size()));
+
+  std::string name, courseName;
+  uint64_t count = 0, bits = 0;
+  size_t position = 0;
+  bool ok = file && getString(in, position, name) &&
+            getVarint(in, position, count);
+  StudentRecord *record = new StudentRecord(std::move(name));
+  for (uint64_t i = 0; ok && i < count; ++i) {
+    ok = getString(in, position, courseName) &&
+         getVarint(in, position, bits);
+    if (ok) {
+      uint32_t word = static_cast<uint32_t>(bits);
+      float grade;
+      std::memcpy(&grade, &word, sizeof(grade));
+      record->courses.add(std::move(courseName), grade);
+    }
+  }
+  ok = ok && position == in.size(); // Zeros read as an empty record
+  if (!ok) {
+    // Leave the node paged out at its position so a later access can retry
+    std::cout << "Error: Could not read student ID " << node->getStudentID()
+              << " from page file '" << path << "'." << std::endl;
+    delete record;
+    readFailures++;
+    static const StudentRecord unreadable{std::string_view("")};
+    return unreadable;
+  }
+
+  node->record = record;
+  admit(node);
+  faults++;
+  return *record;
+}
+
+bool RecordPager::pageOut(const AVLNode *node) {
+  if (node->record == nullptr) {
+    return true;
+  }
+  if (node->pageLength == 0 && !writeOut(node)) {
+    return false;
+  }
+  evict(node->record);
+  delete node->record;
+  node->record = nullptr;
+  pageOuts++;
+  return true;
+}
+
+void RecordPager::trim() {
+  while (residentBytes > budget && oldest != nullptr) {
+    if (!pageOut(oldest->owner)) {
+      std::cout << "Error: Could not write page file '" << path << "'."
+                << std::endl;
+      return;
+    }
+  }
+}
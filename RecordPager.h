@@ -0,0 +1,144 @@
+/**
+ * RecordPager.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Tiered storage for student records (AVLTree::enableTiering). Most
+ * students in a large grade book (alumni, inactive students) are rarely
+ * used, so only the most recently used records stay in memory. The rest are
+ * paged out to a page file and their nodes keep just the tree fields, the
+ * GPA, the hashes and the record's position in the file (80 bytes per
+ * student in all).
+ *
+ * Resident records are kept in least-recently-used order. Whenever the
+ * records charged to the pager exceed its memory budget, the tree pages
+ * out the oldest ones at the start of its next operation, so views returned
+ * by the getters stay valid until then. A record that was not changed since
+ * it was last read from the file is just dropped; otherwise it is appended
+ * to the file. Reading a paged-out record (any AVLNode getter) loads it
+ * back in. If the page file cannot be read, the record stays paged out,
+ * getters see an empty record, edits fail and saves are refused (see
+ * pageInFailures), so the missing courses are never written anywhere.
+ *
+ * Page file format (one entry per page-out, append-only):
+ *   name (length-prefixed), course count, then per course its name
+ *   (length-prefixed) and the grade's IEEE bits, all LEB128 varints (see
+ *   Varint.h)
+ * The file is scratch space: it is created empty and deleted with the pager.
+ *
+ * A pager and every tree using it must stay on one thread, since reading a
+ * record may modify the node and the LRU list.
+ */
+
+#ifndef RECORDPAGER_H
+#define RECORDPAGER_H
+
+#include "AVLNode.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+class RecordPager {
+private:
+  std::fstream file;
+  std::string path;
+  uint64_t fileEnd;
+  size_t budget;        // Bytes of resident records allowed
+  size_t residentBytes; // Bytes charged for the resident records
+  size_t residentCount;
+  StudentRecord *newest;
+  StudentRecord *oldest;
+  size_t users; // Trees and nodes using this pager (see retain)
+
+  // Statistics
+  uint64_t faults;
+  uint64_t pageOuts;
+  uint64_t writes;
+  uint64_t readFailures;
+
+  RecordPager(const std::string &pageFile, size_t budgetBytes);
+  ~RecordPager();
+
+  static size_t recordBytes(const StudentRecord &record);
+  void link(StudentRecord *record);
+  void unlink(StudentRecord *record);
+  void admit(const AVLNode *node);
+  void evict(StudentRecord *record);
+  bool writeOut(const AVLNode *node);
+
+public:
+  RecordPager(const RecordPager &) = delete;
+  RecordPager &operator=(const RecordPager &) = delete;
+
+  /**
+   * Create a pager with an empty page file (replacing any file at that
+   * path). The caller holds the first reference.
+   * @return nullptr if the file cannot be created
+   */
+  static RecordPager *create(const std::string &pageFile, size_t budgetBytes);
+
+  /**
+   * Reference counting: every tree and node using the pager holds one, and
+   * the pager (and its file) is deleted when the last is released
+   */
+  void retain() { users++; }
+  void release();
+
+  /**
+   * Start/stop paging a node's record (called as nodes are created and
+   * destroyed); attach takes a reference, detach releases it
+   */
+  void attach(AVLNode *node);
+  void detach(AVLNode *node);
+
+  /**
+   * Mark a node's record as the most recently used (no effect if it is
+   * paged out)
+   * Time Complexity: O(1)
+   */
+  void touch(const AVLNode *node);
+
+  /**
+   * Re-charge a resident record after its courses changed
+   * Time Complexity: O(m) for m courses
+   */
+  void resized(StudentRecord *record);
+
+  /**
+   * Read a paged-out record back in as the most recently used
+   * Time Complexity: O(record size) plus one file read
+   * @return The record; an empty stand-in, with the node left paged out,
+   *         if it could not be read
+   */
+  const StudentRecord &pageIn(const AVLNode *node);
+
+  /**
+   * Page out one node's record (writing it if it changed)
+   * @return false if it could not be written (it stays resident)
+   */
+  bool pageOut(const AVLNode *node);
+
+  /**
+   * Page out least recently used records until the rest fit the budget
+   * Time Complexity: O(k) records paged out
+   */
+  void trim();
+
+  void setBudget(size_t budgetBytes) { budget = budgetBytes; }
+  size_t budgetBytes() const { return budget; }
+  size_t residentRecordBytes() const { return residentBytes; }
+  size_t residentRecords() const { return residentCount; }
+  uint64_t pageFileBytes() const { return fileEnd; }
+  uint64_t pageFaults() const { return faults; }
+  uint64_t recordsPagedOut() const { return pageOuts; }
+  uint64_t recordsWritten() const { return writes; }
+
+  /**
+   * Number of records that could not be read back so far. A save that
+   * raised it left students out and must not replace the file.
+   */
+  uint64_t pageInFailures() const { return readFailures; }
+};
+
+#endif // RECORDPAGER_H
@@ -0,0 +1,163 @@
+/**
+ * ShortString.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Defines the ShortString class - a string with inline storage for up to
+ * INLINE_CAPACITY characters. Nearly all student and course names fit, so
+ * storing a name costs no heap allocation. Longer names spill into a
+ * std::string held in the same storage; constructing from an rvalue
+ * std::string adopts its buffer instead of copying it.
+ */
+
+#ifndef SHORTSTRING_H
+#define SHORTSTRING_H
+
+#include <cstring>
+#include <new>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+class ShortString {
+public:
+  static const size_t INLINE_CAPACITY = 31;
+
+private:
+  typedef std::string HeapString;
+  static const unsigned char HEAP_MARKER = 0xFF;
+
+  union {
+    char inlineBuf[INLINE_CAPACITY + 1];
+    HeapString heapStr;
+  };
+  unsigned char inlineSize; // HEAP_MARKER when heapStr is the active member
+
+  bool isHeap() const { return inlineSize == HEAP_MARKER; }
+
+  void destroyHeap() {
+    heapStr.~HeapString();
+    inlineSize = 0;
+    inlineBuf[0] = '\0';
+  }
+
+  void setInline(const char *s, size_t n) {
+    std::memmove(inlineBuf, s, n);
+    inlineBuf[n] = '\0';
+    inlineSize = static_cast<unsigned char>(n);
+  }
+
+public:
+  ShortString() : inlineSize(0) { inlineBuf[0] = '\0'; }
+
+  ShortString(const char *s, size_t n) : inlineSize(0) {
+    inlineBuf[0] = '\0';
+    assign(s, n);
+  }
+
+  explicit ShortString(std::string_view s) : inlineSize(0) {
+    inlineBuf[0] = '\0';
+    assign(s.data(), s.size());
+  }
+
+  explicit ShortString(std::string &&s) : inlineSize(0) {
+    if (s.size() > INLINE_CAPACITY) {
+      new (&heapStr) HeapString(std::move(s));
+      inlineSize = HEAP_MARKER;
+    } else {
+      setInline(s.data(), s.size());
+    }
+  }
+
+  ShortString(const ShortString &other) : inlineSize(0) {
+    inlineBuf[0] = '\0';
+    assign(other.data(), other.size());
+  }
+
+  ShortString(ShortString &&other) : inlineSize(0) {
+    if (other.isHeap()) {
+      new (&heapStr) HeapString(std::move(other.heapStr));
+      inlineSize = HEAP_MARKER;
+    } else {
+      setInline(other.inlineBuf, other.inlineSize);
+    }
+  }
+
+  ~ShortString() {
+    if (isHeap()) {
+      heapStr.~HeapString();
+    }
+  }
+
+  ShortString &operator=(const ShortString &other) {
+    if (this != &other) {
+      assign(other.data(), other.size());
+    }
+    return *this;
+  }
+
+  ShortString &operator=(ShortString &&other) {
+    if (this == &other) {
+      return *this;
+    }
+    if (other.isHeap()) {
+      if (isHeap()) {
+        heapStr = std::move(other.heapStr);
+      } else {
+        new (&heapStr) HeapString(std::move(other.heapStr));
+        inlineSize = HEAP_MARKER;
+      }
+    } else {
+      assign(other.inlineBuf, other.inlineSize);
+    }
+    return *this;
+  }
+
+  void assign(const char *s, size_t n) {
+    if (isHeap()) {
+      if (n > INLINE_CAPACITY) {
+        heapStr.assign(s, n);
+        return;
+      }
+      // Copy out before releasing in case s points into heapStr
+      char tmp[INLINE_CAPACITY + 1];
+      std::memcpy(tmp, s, n);
+      destroyHeap();
+      setInline(tmp, n);
+      return;
+    }
+
+    if (n <= INLINE_CAPACITY) {
+      setInline(s, n);
+    } else {
+      new (&heapStr) HeapString(s, n);
+      inlineSize = HEAP_MARKER;
+    }
+  }
+
+  const char *data() const { return isHeap() ? heapStr.data() : inlineBuf; }
+  const char *c_str() const { return isHeap() ? heapStr.c_str() : inlineBuf; }
+  size_t size() const { return isHeap() ? heapStr.size() : inlineSize; }
+  bool empty() const { return size() == 0; }
+
+  std::string_view view() const { return std::string_view(data(), size()); }
+  std::string str() const { return std::string(data(), size()); }
+
+  // Heap memory held beyond sizeof(ShortString)
+  size_t heapBytes() const { return isHeap() ? heapStr.capacity() + 1 : 0; }
+
+  bool operator==(const ShortString &other) const {
+    return view() == other.view();
+  }
+  bool operator!=(const ShortString &other) const { return !(*this == other); }
+
+  bool operator==(std::string_view other) const { return view() == other; }
+  bool operator!=(std::string_view other) const { return view() != other; }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const ShortString &s) {
+  return os << s.view();
+}
+
+#endif // SHORTSTRING_H
@@ -0,0 +1,175 @@
+/**
+ * SmallVector.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Defines the SmallVector class template - a vector that keeps its first N
+ * elements inside the object and only allocates on the heap once it grows
+ * past N. Used for course lists, where a typical course load fits inline.
+ */
+
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename T, size_t N> class SmallVector {
+private:
+  typename std::aligned_storage<sizeof(T), alignof(T)>::type inlineStore[N];
+  T *elems;
+  size_t count;
+  size_t cap;
+
+  T *inlineData() { return reinterpret_cast<T *>(inlineStore); }
+  bool isInline() const {
+    return elems == reinterpret_cast<const T *>(inlineStore);
+  }
+
+  // Move all elements into a buffer of newCap elements
+  void grow(size_t newCap) {
+    moveTo(static_cast<T *>(::operator new(newCap * sizeof(T))), newCap);
+  }
+
+  void moveTo(T *fresh, size_t newCap) {
+    for (size_t i = 0; i < count; ++i) {
+      new (fresh + i) T(std::move(elems[i]));
+      elems[i].~T();
+    }
+    releaseBuffer();
+    elems = fresh;
+    cap = newCap;
+  }
+
+  // Grow a full vector and append. The new element is constructed before
+  // the old ones move, since args may refer to one of them (as in
+  // v.push_back(v[0])).
+  template <typename... Args> void growAndEmplace(Args &&...args) {
+    size_t newCap = cap * 2;
+    T *fresh = static_cast<T *>(::operator new(newCap * sizeof(T)));
+    new (fresh + count) T(std::forward<Args>(args)...);
+    moveTo(fresh, newCap);
+    ++count;
+  }
+
+  void releaseBuffer() {
+    if (!isInline()) {
+      ::operator delete(elems);
+    }
+  }
+
+  void destroyAll() {
+    for (size_t i = 0; i < count; ++i) {
+      elems[i].~T();
+    }
+    count = 0;
+  }
+
+  // Take over other's elements; other is left empty
+  void stealFrom(SmallVector &other) {
+    if (other.isInline()) {
+      for (size_t i = 0; i < other.count; ++i) {
+        new (elems + i) T(std::move(other.elems[i]));
+      }
+      count = other.count;
+      other.destroyAll();
+    } else {
+      elems = other.elems;
+      count = other.count;
+      cap = other.cap;
+      other.elems = other.inlineData();
+      other.count = 0;
+      other.cap = N;
+    }
+  }
+
+public:
+  typedef T *iterator;
+  typedef const T *const_iterator;
+
+  SmallVector() : elems(inlineData()), count(0), cap(N) {}
+
+  SmallVector(const SmallVector &other)
+      : elems(inlineData()), count(0), cap(N) {
+    reserve(other.count);
+    for (size_t i = 0; i < other.count; ++i) {
+      new (elems + i) T(other.elems[i]);
+    }
+    count = other.count;
+  }
+
+  SmallVector(SmallVector &&other) : elems(inlineData()), count(0), cap(N) {
+    stealFrom(other);
+  }
+
+  ~SmallVector() {
+    destroyAll();
+    releaseBuffer();
+  }
+
+  SmallVector &operator=(const SmallVector &other) {
+    if (this != &other) {
+      destroyAll();
+      reserve(other.count);
+      for (size_t i = 0; i < other.count; ++i) {
+        new (elems + i) T(other.elems[i]);
+      }
+      count = other.count;
+    }
+    return *this;
+  }
+
+  SmallVector &operator=(SmallVector &&other) {
+    if (this != &other) {
+      destroyAll();
+      releaseBuffer();
+      elems = inlineData();
+      cap = N;
+      stealFrom(other);
+    }
+    return *this;
+  }
+
+  void reserve(size_t n) {
+    if (n > cap) {
+      grow(n);
+    }
+  }
+
+  template <typename... Args> void emplace_back(Args &&...args) {
+    if (count == cap) {
+      growAndEmplace(std::forward<Args>(args)...);
+      return;
+    }
+    new (elems + count) T(std::forward<Args>(args)...);
+    ++count;
+  }
+
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+  void push_back(const T &value) { emplace_back(value); }
+
+  void pop_back() {
+    --count;
+    elems[count].~T();
+  }
+
+  void clear() { destroyAll(); }
+
+  size_t size() const { return count; }
+  size_t capacity() const { return cap; }
+  bool empty() const { return count == 0; }
+  bool onHeap() const { return !isInline(); }
+
+  T &operator[](size_t i) { return elems[i]; }
+  const T &operator[](size_t i) const { return elems[i]; }
+  T &back() { return elems[count - 1]; }
+
+  iterator begin() { return elems; }
+  iterator end() { return elems + count; }
+  const_iterator begin() const { return elems; }
+  const_iterator end() const { return elems + count; }
+};
+
+#endif // SMALLVECTOR_H
@@ -0,0 +1,111 @@
+/**
+ * StudentIndex.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the student ID hash index.
+ */
+
+#include "StudentIndex.h"
+#include "Prefetch.h"
+#include <algorithm>
+
+namespace {
+
+const size_t INITIAL_CAPACITY = 16;
+const int INITIAL_SHIFT = 64 - 4;
+const size_t PREFETCH_GROUP = 16; // Lookups in flight at once
+
+} // namespace
+
+StudentIndex::StudentIndex()
+    : slots(INITIAL_CAPACITY, Slot{0, nullptr}), count(0),
+      shift(INITIAL_SHIFT) {}
+
+void StudentIndex::findMany(const int *studentIDs, size_t count,
+                            AVLNode **nodes) const {
+  for (size_t first = 0; first < count; first += PREFETCH_GROUP) {
+    size_t last = std::min(count, first + PREFETCH_GROUP);
+    for (size_t i = first; i < last; ++i) {
+      prefetchRead(&slots[home(studentIDs[i])]);
+    }
+    for (size_t i = first; i < last; ++i) {
+      nodes[i] = find(studentIDs[i]);
+      if (nodes[i] != nullptr) {
+        prefetchRead(nodes[i]); // The caller reads the record next
+      }
+    }
+  }
+}
+
+void StudentIndex::set(int studentID, AVLNode *node) {
+  size_t mask = slots.size() - 1;
+  size_t i = home(studentID);
+  while (slots[i].node != nullptr) {
+    if (slots[i].studentID == studentID) {
+      slots[i].node = node;
+      return;
+    }
+    i = (i + 1) & mask;
+  }
+  slots[i] = Slot{studentID, node};
+  if (++count * 2 > slots.size()) {
+    grow();
+  }
+}
+
+void StudentIndex::erase(int studentID) {
+  size_t mask = slots.size() - 1;
+  size_t hole = home(studentID);
+  while (slots[hole].studentID != studentID) {
+    if (slots[hole].node == nullptr) {
+      return; // Not indexed
+    }
+    hole = (hole + 1) & mask;
+  }
+  if (slots[hole].node == nullptr) {
+    return;
+  }
+
+  // Backward-shift deletion: move later entries of the probe run into the
+  // hole unless their home slot lies cyclically in (hole, i]
+  size_t i = hole;
+  for (;;) {
+    i = (i + 1) & mask;
+    if (slots[i].node == nullptr) {
+      break;
+    }
+    size_t h = home(slots[i].studentID);
+    bool stays = (hole < i) ? (h > hole && h <= i) : (h > hole || h <= i);
+    if (!stays) {
+      slots[hole] = slots[i];
+      hole = i;
+    }
+  }
+  slots[hole] = Slot{0, nullptr};
+  count--;
+}
+
+// Double the table and re-insert every entry
+void StudentIndex::grow() {
+  std::vector<Slot> old(slots.size() * 2, Slot{0, nullptr});
+  old.swap(slots);
+  shift--;
+
+  size_t mask = slots.size() - 1;
+  for (const Slot &slot : old) {
+    if (slot.node != nullptr) {
+      size_t i = home(slot.studentID);
+      while (slots[i].node != nullptr) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = slot;
+    }
+  }
+}
+
+void StudentIndex::clear() {
+  std::vector<Slot>(INITIAL_CAPACITY, Slot{0, nullptr}).swap(slots);
+  count = 0;
+  shift = INITIAL_SHIFT;
+}
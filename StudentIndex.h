@@ -0,0 +1,86 @@
+/**
+ * StudentIndex.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Hash index from student ID to the tree node holding that student, kept by
+ * AVLTree next to the ordered tree so point lookups cost O(1) instead of an
+ * O(log n) descent. Open addressing with linear probing; erasing shifts
+ * later entries back instead of leaving tombstones.
+ */
+
+#ifndef STUDENTINDEX_H
+#define STUDENTINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class AVLNode;
+
+class StudentIndex {
+private:
+  struct Slot {
+    int studentID;
+    AVLNode *node; // nullptr marks an empty slot
+  };
+
+  std::vector<Slot> slots; // Power-of-two size, at most half full
+  size_t count;
+  int shift; // 64 - log2(slots.size())
+
+  size_t home(int studentID) const {
+    // Fibonacci hashing spreads consecutive IDs across the table
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(static_cast<uint32_t>(studentID)) *
+         0x9E3779B97F4A7C15ull) >>
+        shift);
+  }
+
+  void grow();
+
+public:
+  StudentIndex();
+
+  /**
+   * Node of a student, or nullptr if the ID is not indexed
+   * Time Complexity: O(1) expected
+   */
+  AVLNode *find(int studentID) const {
+    size_t mask = slots.size() - 1;
+    for (size_t i = home(studentID);; i = (i + 1) & mask) {
+      const Slot &slot = slots[i];
+      if (slot.node == nullptr || slot.studentID == studentID) {
+        return slot.node;
+      }
+    }
+  }
+
+  /**
+   * Look up count IDs at once: the slots of a whole group are prefetched
+   * before any of them is probed, so their cache misses overlap
+   * @param nodes Receives the node of each ID (nullptr if not indexed)
+   */
+  void findMany(const int *studentIDs, size_t count, AVLNode **nodes) const;
+
+  /**
+   * Point a student ID at a node, adding the ID if it is new
+   * Time Complexity: O(1) amortized
+   */
+  void set(int studentID, AVLNode *node);
+
+  /**
+   * Remove a student ID (no effect if it is not indexed)
+   * Time Complexity: O(1) expected
+   */
+  void erase(int studentID);
+
+  /**
+   * Remove every entry and shrink back to the initial capacity
+   */
+  void clear();
+
+  size_t size() const { return count; }
+};
+
+#endif // STUDENTINDEX_H
@@ -0,0 +1,68 @@
+/**
+ * Varint.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * LEB128 varint and length-prefixed string encoding shared by the binary
+ * file formats (GradeArchive.h, WorkloadTrace.h).
+ */
+
+#ifndef VARINT_H
+#define VARINT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+inline void putVarint(std::string &out, uint64_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+inline void putString(std::string &out, std::string_view text) {
+  putVarint(out, text.size());
+  out.append(text.data(), text.size());
+}
+
+// Map signed values to unsigned so small negatives stay short
+inline uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Decode a varint from a buffer, advancing position
+inline bool getVarint(const std::string &in, size_t &position,
+                      uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (position >= in.size()) {
+      return false;
+    }
+    unsigned char byte = static_cast<unsigned char>(in[position++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool getString(const std::string &in, size_t &position,
+                      std::string &text) {
+  uint64_t length;
+  if (!getVarint(in, position, length) || length > in.size() - position) {
+    return false;
+  }
+  text.assign(in, position, length);
+  position += length;
+  return true;
+}
+
+#endif // VARINT_H
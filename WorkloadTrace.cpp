@@ -0,0 +1,375 @@
+/**
+ * WorkloadTrace.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Implementation of the workload trace recorder, reader and replay step.
+ */
+
+#include "WorkloadTrace.h"
+#include "AVLTree.h"
+#include "Varint.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+const char MAGIC[] = {'P', 'S', '5', 'W', 'L', 'T'};
+const uint64_t FORMAT_VERSION = 1;
+const size_t FLUSH_BYTES = 64 * 1024;
+
+const char *const KIND_NAMES[TraceRecord::KIND_COUNT] = {
+    "?",           "insert",       "search",        "rank",
+    "updateCourse", "addCourse",   "deleteCourse",  "deleteStudent",
+    "saveVersion", "dropVersion"};
+
+void hashBytes(uint64_t &hash, const void *data, size_t length) {
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+}
+
+void putFixed(std::string &out, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; ++i) {
+    out += static_cast<char>((value >> (8 * i)) & 0xFF);
+  }
+}
+
+bool getFixed(const std::string &in, size_t &position, int bytes,
+              uint64_t &value) {
+  if (in.size() - position < static_cast<size_t>(bytes)) {
+    return false;
+  }
+  value = 0;
+  for (int i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(static_cast<unsigned char>(in[position++]))
+             << (8 * i);
+  }
+  return true;
+}
+
+// Which fields a record kind carries
+bool hasID(TraceRecord::Kind kind) {
+  return kind != TraceRecord::SAVE_VERSION &&
+         kind != TraceRecord::DROP_VERSION;
+}
+
+bool hasName(TraceRecord::Kind kind) {
+  return kind == TraceRecord::INSERT || !hasID(kind);
+}
+
+bool hasCourse(TraceRecord::Kind kind) {
+  return kind == TraceRecord::INSERT || kind == TraceRecord::UPDATE_COURSE ||
+         kind == TraceRecord::ADD_COURSE || kind == TraceRecord::DELETE_COURSE;
+}
+
+bool hasGrade(TraceRecord::Kind kind) {
+  return kind == TraceRecord::INSERT || kind == TraceRecord::UPDATE_COURSE ||
+         kind == TraceRecord::ADD_COURSE;
+}
+
+} // namespace
+
+TreeFingerprint fingerprintTree(const AVLTree &tree) {
+  TreeFingerprint result = {0, 0, 14695981039346656037ull, false};
+  tree.forEachStudent([&](const AVLNode &student) {
+    int id = student.getStudentID();
+    std::string_view name = student.getName();
+    hashBytes(result.hash, &id, sizeof(id));
+    hashBytes(result.hash, name.data(), name.size());
+    for (const auto &course : student.getCourses()) {
+      std::string_view courseName = course.courseName.view();
+      hashBytes(result.hash, courseName.data(), courseName.size());
+      hashBytes(result.hash, &course.grade, sizeof(course.grade));
+      result.courses++;
+    }
+    result.students++;
+  });
+  return result;
+}
+
+// ==================== RECORDER ====================
+
+WorkloadRecorder::WorkloadRecorder() : previousID(0), recorded(0) {}
+
+bool WorkloadRecorder::open(const std::string &filename) {
+  file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  buffer.assign(MAGIC, sizeof(MAGIC));
+  putVarint(buffer, FORMAT_VERSION);
+  previousID = 0;
+  recorded = 0;
+  return true;
+}
+
+void WorkloadRecorder::begin(TraceRecord::Kind kind, int studentID) {
+  buffer += static_cast<char>(kind);
+  if (hasID(kind)) {
+    putVarint(buffer, zigzag(static_cast<int64_t>(studentID) - previousID));
+    previousID = studentID;
+  }
+  recorded++;
+}
+
+void WorkloadRecorder::putGrade(float grade) {
+  uint32_t bits;
+  std::memcpy(&bits, &grade, sizeof(bits));
+  putFixed(buffer, bits, 4);
+}
+
+void WorkloadRecorder::flushIfFull() {
+  if (buffer.size() >= FLUSH_BYTES) {
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+void WorkloadRecorder::insert(int studentID, std::string_view name,
+                              std::string_view course, float grade) {
+  begin(TraceRecord::INSERT, studentID);
+  putString(buffer, name);
+  putString(buffer, course);
+  putGrade(grade);
+  flushIfFull();
+}
+
+void WorkloadRecorder::search(int studentID) {
+  begin(TraceRecord::SEARCH, studentID);
+  flushIfFull();
+}
+
+void WorkloadRecorder::rank(int studentID) {
+  begin(TraceRecord::RANK, studentID);
+  flushIfFull();
+}
+
+void WorkloadRecorder::updateCourse(int studentID, std::string_view course,
+                                    float grade) {
+  begin(TraceRecord::UPDATE_COURSE, studentID);
+  putString(buffer, course);
+  putGrade(grade);
+  flushIfFull();
+}
+
+void WorkloadRecorder::addCourse(int studentID, std::string_view course,
+                                 float grade) {
+  begin(TraceRecord::ADD_COURSE, studentID);
+  putString(buffer, course);
+  putGrade(grade);
+  flushIfFull();
+}
+
+void WorkloadRecorder::deleteCourse(int studentID, std::string_view course) {
+  begin(TraceRecord::DELETE_COURSE, studentID);
+  putString(buffer, course);
+  flushIfFull();
+}
+
+void WorkloadRecorder::deleteStudent(int studentID) {
+  begin(TraceRecord::DELETE_STUDENT, studentID);
+  flushIfFull();
+}
+
+void WorkloadRecorder::saveVersion(std::string_view label) {
+  begin(TraceRecord::SAVE_VERSION, 0);
+  putString(buffer, label);
+  flushIfFull();
+}
+
+void WorkloadRecorder::dropVersion(std::string_view label) {
+  begin(TraceRecord::DROP_VERSION, 0);
+  putString(buffer, label);
+  flushIfFull();
+}
+
+bool WorkloadRecorder::finish(const AVLTree &tree) {
+  if (!file.is_open()) {
+    return false;
+  }
+  return writeEnd(TraceRecord::END, fingerprintTree(tree));
+}
+
+bool WorkloadRecorder::finishChangeSet(const AVLTree &result) {
+  if (!file.is_open()) {
+    return false;
+  }
+  TreeFingerprint state = fingerprintTree(result); // For the counts
+  state.hash = result.contentHash();
+  return writeEnd(TraceRecord::CHANGE_SET_END, state);
+}
+
+bool WorkloadRecorder::writeEnd(TraceRecord::Kind kind,
+                                const TreeFingerprint &state) {
+  buffer += static_cast<char>(kind);
+  putVarint(buffer, static_cast<uint64_t>(state.students));
+  putVarint(buffer, static_cast<uint64_t>(state.courses));
+  putFixed(buffer, state.hash, 8);
+
+  file.write(buffer.data(), buffer.size());
+  buffer.clear();
+  file.close();
+  return !file.fail();
+}
+
+// ==================== READER ====================
+
+bool readWorkloadTrace(const std::string &filename,
+                       std::vector<TraceRecord> &records, bool &hasFinalState,
+                       TreeFingerprint &finalState, std::string &error) {
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    error = "could not open '" + filename + "'";
+    return false;
+  }
+  std::stringstream contents;
+  contents << file.rdbuf();
+  const std::string data = contents.str();
+
+  size_t position = sizeof(MAGIC);
+  uint64_t version;
+  if (data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0 ||
+      !getVarint(data, position, version)) {
+    error = "not a workload trace";
+    return false;
+  }
+  if (version != FORMAT_VERSION) {
+    error = "unsupported trace version";
+    return false;
+  }
+
+  records.clear();
+  hasFinalState = false;
+  int previousID = 0;
+  while (position < data.size()) {
+    TraceRecord record;
+    record.kind = static_cast<TraceRecord::Kind>(
+        static_cast<unsigned char>(data[position++]));
+    record.studentID = 0;
+    record.grade = 0;
+
+    if (record.kind == TraceRecord::END ||
+        record.kind == TraceRecord::CHANGE_SET_END) {
+      uint64_t students, courses, hash;
+      if (!getVarint(data, position, students) ||
+          !getVarint(data, position, courses) ||
+          !getFixed(data, position, 8, hash)) {
+        error = "damaged end record";
+        return false;
+      }
+      finalState.students = static_cast<int>(students);
+      finalState.courses = static_cast<int>(courses);
+      finalState.hash = hash;
+      finalState.changeSet = record.kind == TraceRecord::CHANGE_SET_END;
+      hasFinalState = true;
+      return true;
+    }
+    if (record.kind < TraceRecord::INSERT ||
+        record.kind >= TraceRecord::KIND_COUNT) {
+      error = "unknown record kind";
+      return false;
+    }
+
+    uint64_t delta, bits;
+    bool ok = true;
+    if (hasID(record.kind)) {
+      ok = getVarint(data, position, delta);
+      record.studentID = previousID + static_cast<int>(unzigzag(delta));
+      previousID = record.studentID;
+    }
+    if (ok && hasName(record.kind)) {
+      ok = getString(data, position, record.name);
+    }
+    if (ok && hasCourse(record.kind)) {
+      ok = getString(data, position, record.course);
+    }
+    if (ok && hasGrade(record.kind)) {
+      ok = getFixed(data, position, 4, bits);
+      uint32_t grade = static_cast<uint32_t>(bits);
+      std::memcpy(&record.grade, &grade, sizeof(record.grade));
+    }
+    if (!ok) {
+      // A record cut off at the end of the file: the run was interrupted
+      return true;
+    }
+    records.push_back(std::move(record));
+  }
+  return true;
+}
+
+// ==================== REPLAY ====================
+
+void replayRecord(AVLTree &tree, const TraceRecord &record) {
+  switch (record.kind) {
+  case TraceRecord::INSERT:
+    tree.insert(record.studentID, record.name, record.course, record.grade);
+    break;
+  case TraceRecord::SEARCH:
+    tree.search(record.studentID);
+    break;
+  case TraceRecord::RANK:
+    tree.rank(record.studentID);
+    break;
+  case TraceRecord::UPDATE_COURSE:
+    tree.updateCourse(record.studentID, record.course, record.grade);
+    break;
+  case TraceRecord::ADD_COURSE:
+    tree.addCourseToStudent(record.studentID, record.course, record.grade);
+    break;
+  case TraceRecord::DELETE_COURSE:
+    tree.deleteCourse(record.studentID, record.course);
+    break;
+  case TraceRecord::DELETE_STUDENT:
+    tree.deleteStudent(record.studentID);
+    break;
+  case TraceRecord::SAVE_VERSION:
+    tree.saveVersion(record.name);
+    break;
+  case TraceRecord::DROP_VERSION:
+    tree.dropVersion(record.name);
+    break;
+  default:
+    break;
+  }
+}
+
+bool writeChangeSet(const std::string &filename,
+                    const std::vector<TraceRecord> &changes,
+                    const AVLTree &result) {
+  WorkloadRecorder recorder;
+  if (!recorder.open(filename)) {
+    return false;
+  }
+  for (const TraceRecord &change : changes) {
+    switch (change.kind) {
+    case TraceRecord::INSERT:
+      recorder.insert(change.studentID, change.name, change.course,
+                      change.grade);
+      break;
+    case TraceRecord::UPDATE_COURSE:
+      recorder.updateCourse(change.studentID, change.course, change.grade);
+      break;
+    case TraceRecord::ADD_COURSE:
+      recorder.addCourse(change.studentID, change.course, change.grade);
+      break;
+    case TraceRecord::DELETE_COURSE:
+      recorder.deleteCourse(change.studentID, change.course);
+      break;
+    case TraceRecord::DELETE_STUDENT:
+      recorder.deleteStudent(change.studentID);
+      break;
+    default:
+      break; // Not a change
+    }
+  }
+  return recorder.finishChangeSet(result);
+}
+
+const char *traceKindName(TraceRecord::Kind kind) {
+  if (kind > 0 && kind < TraceRecord::KIND_COUNT) {
+    return KIND_NAMES[kind];
+  }
+  return "?";
+}
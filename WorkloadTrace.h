@@ -0,0 +1,161 @@
+/**
+ * WorkloadTrace.h
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Records every operation issued against an AVLTree to a compact trace file
+ * (".wlt") so real usage (update runs after exams, mass deletes at
+ * graduation, ...) can be replayed at full speed by GradeReplay.
+ *
+ * Layout:
+ *   header  "PS5WLT" magic, format version (varint)
+ *   record* kind (1 byte), then by kind:
+ *           student ID as a zigzag varint delta from the previous record's ID,
+ *           name/course/label as varint length + bytes,
+ *           grade as the 4 raw bytes of the float (little endian)
+ *   end     kind END, student count, course count (varints) and the 8-byte
+ *           fingerprint of the final tree (see fingerprintTree)
+ *
+ * A change set (see writeChangeSet) has the same layout but ends with kind
+ * CHANGE_SET_END, whose hash is AVLTree::contentHash() of the tree the
+ * changes lead to. It applies to the grade book it was made from, so its
+ * final state is not checked by replaying it against an empty tree.
+ *
+ * A trace without an end record (the program was killed) still replays;
+ * only the final state check is skipped.
+ */
+
+#ifndef WORKLOADTRACE_H
+#define WORKLOADTRACE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class AVLTree;
+
+struct TraceRecord {
+  enum Kind {
+    INSERT = 1,
+    SEARCH,
+    RANK,
+    UPDATE_COURSE,
+    ADD_COURSE,
+    DELETE_COURSE,
+    DELETE_STUDENT,
+    SAVE_VERSION,
+    DROP_VERSION,
+    KIND_COUNT,
+    CHANGE_SET_END = 0xFE,
+    END = 0xFF
+  };
+
+  Kind kind;
+  int studentID;
+  std::string name; // Student name, or the label of a version operation
+  std::string course;
+  float grade;
+};
+
+// Summary of a tree's contents, used to check that a replay ends in the same
+// state as the recorded run
+struct TreeFingerprint {
+  int students;
+  int courses;
+  uint64_t hash;
+  bool changeSet; // hash is AVLTree::contentHash() (see writeChangeSet)
+
+  bool operator==(const TreeFingerprint &other) const {
+    return students == other.students && courses == other.courses &&
+           hash == other.hash;
+  }
+};
+
+/**
+ * FNV-1a hash over every student ID, name, course name and grade in ID order
+ * Time Complexity: O(n * m)
+ */
+TreeFingerprint fingerprintTree(const AVLTree &tree);
+
+class WorkloadRecorder {
+private:
+  std::ofstream file;
+  std::string buffer;
+  int previousID;
+  uint64_t recorded;
+
+  void begin(TraceRecord::Kind kind, int studentID);
+  void putGrade(float grade);
+  void flushIfFull();
+  bool writeEnd(TraceRecord::Kind kind, const TreeFingerprint &state);
+
+public:
+  WorkloadRecorder();
+
+  /**
+   * Create the trace file and write its header
+   * @return false if the file could not be created
+   */
+  bool open(const std::string &filename);
+
+  bool isOpen() const { return file.is_open(); }
+  uint64_t recordedOperations() const { return recorded; }
+
+  // One call per AVLTree operation (made by AVLTree itself, see setRecorder)
+  void insert(int studentID, std::string_view name, std::string_view course,
+              float grade);
+  void search(int studentID);
+  void rank(int studentID);
+  void updateCourse(int studentID, std::string_view course, float grade);
+  void addCourse(int studentID, std::string_view course, float grade);
+  void deleteCourse(int studentID, std::string_view course);
+  void deleteStudent(int studentID);
+  void saveVersion(std::string_view label);
+  void dropVersion(std::string_view label);
+
+  /**
+   * Write the end record with the fingerprint of the final tree and close
+   * @return true if the whole trace was written successfully
+   */
+  bool finish(const AVLTree &tree);
+
+  /**
+   * Write the end record of a change set (the counts and content hash of
+   * result, see writeChangeSet) and close
+   */
+  bool finishChangeSet(const AVLTree &result);
+};
+
+/**
+ * Read a whole trace file into memory
+ * @param finalState Set to the recorded final state if the trace has one
+ * @return false if the file is missing or damaged (error says why)
+ */
+bool readWorkloadTrace(const std::string &filename,
+                       std::vector<TraceRecord> &records, bool &hasFinalState,
+                       TreeFingerprint &finalState, std::string &error);
+
+/**
+ * Apply one recorded operation to a tree
+ */
+void replayRecord(AVLTree &tree, const TraceRecord &record);
+
+/**
+ * Save a change set (see AVLTree::diff) as a trace file, ending with the
+ * student and course counts and the content hash of result, the tree the
+ * changes lead to. A tree the changes were applied to matches result if
+ * its contentHash() equals finalState.hash as read back.
+ * @return false if the file could not be written
+ */
+bool writeChangeSet(const std::string &filename,
+                    const std::vector<TraceRecord> &changes,
+                    const AVLTree &result);
+
+/**
+ * Short name of a record kind for reports ("insert", "search", ...)
+ */
+const char *traceKindName(TraceRecord::Kind kind);
+
+#endif // WORKLOADTRACE_H
@@ -0,0 +1,143 @@
+/**
+ * alloccheck.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Checks that the read API allocates nothing. Global operator new and
+ * delete are replaced with versions that count calls. The program loads a
+ * grade book, then runs search, getName, hasCourse and findCourse for
+ * present and missing students and courses in the indexed tree, in a copy
+ * (which descends the tree) and in a frozen copy, and counts the
+ * allocations made meanwhile. Exits with status 1 if there were any.
+ *
+ * Usage: GradeAllocCheck [-s students]
+ */
+
+#include "AVLTree.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+
+using namespace std;
+
+// ==================== COUNTING ALLOCATOR ====================
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+  allocations++;
+  void *memory = malloc(size == 0 ? 1 : size);
+  if (memory == nullptr) {
+    throw bad_alloc();
+  }
+  return memory;
+}
+
+void *operator new(size_t size, align_val_t alignment) {
+  allocations++;
+  size_t align = static_cast<size_t>(alignment);
+  // aligned_alloc needs a size that is a multiple of the alignment
+  void *memory = aligned_alloc(align, (size + align - 1) / align * align);
+  if (memory == nullptr) {
+    throw bad_alloc();
+  }
+  return memory;
+}
+
+// The array and nothrow forms call these by default
+void operator delete(void *memory) noexcept { free(memory); }
+void operator delete(void *memory, size_t) noexcept { free(memory); }
+void operator delete(void *memory, align_val_t) noexcept { free(memory); }
+void operator delete(void *memory, size_t, align_val_t) noexcept {
+  free(memory);
+}
+
+// ==================== CHECKS ====================
+
+// Course names are long enough that copying one would allocate
+const int COURSES = 12; // More than CourseList keeps inline or scans
+const char *const COURSE_NAMES[COURSES] = {
+    "Data Structures", "Algorithm Analysis", "Operating Systems",
+    "Computer Networks", "Database Systems", "Software Engineering",
+    "Compiler Construction", "Computer Graphics", "Machine Learning",
+    "Distributed Systems", "Information Security", "Numerical Methods"};
+const char *const MISSING_COURSE = "Underwater Basket Weaving";
+
+// Run the lookups for every student ID (and one past the end) and return
+// the number of allocations they made
+static size_t countLookups(AVLTree &tree, int students) {
+  size_t before = allocations;
+  size_t found = 0;
+  for (int id = 1; id <= students + 1; ++id) {
+    AVLNode *student = tree.search(id);
+    if (student == nullptr) {
+      continue;
+    }
+    string_view name = student->getName();
+    found += name.size();
+    for (const char *course : COURSE_NAMES) {
+      found += student->hasCourse(course) ? 1 : 0;
+      const CourseRecord *record = student->findCourse(course);
+      found += record != nullptr && record->grade >= 0 ? 1 : 0;
+    }
+    found += student->hasCourse(MISSING_COURSE) ? 1 : 0;
+    found += student->findCourse(MISSING_COURSE) != nullptr ? 1 : 0;
+  }
+  size_t made = allocations - before;
+  if (found == 0) {
+    cout << "  (no students found)\n";
+  }
+  return made;
+}
+
+static bool check(const char *label, AVLTree &tree, int students) {
+  size_t made = countLookups(tree, students);
+  cout << "  " << label << ": " << made << " allocations\n";
+  return made == 0;
+}
+
+int main(int argc, char *argv[]) {
+  int students = 10000;
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (i + 1 < argc && arg == "-s") {
+      students = atoi(argv[++i]);
+    } else {
+      students = 0;
+      break;
+    }
+  }
+  if (students < 1) {
+    cout << "Usage: " << argv[0] << " [-s students]\n";
+    return 1;
+  }
+
+  // Half the students have three courses (kept inline), half all twelve
+  AVLTree tree;
+  streambuf *console = cout.rdbuf(nullptr);
+  for (int id = 1; id <= students; ++id) {
+    int courses = id % 2 == 0 ? COURSES : 3;
+    for (int c = 0; c < courses; ++c) {
+      tree.insert(id, "Student Number " + to_string(id), COURSE_NAMES[c],
+                  static_cast<float>((id + c) % 101));
+    }
+  }
+  cout.rdbuf(console);
+  cout.clear();
+
+  AVLTree copy(tree);
+  AVLTree frozen(tree);
+  frozen.freeze();
+
+  cout << "Lookups in " << students << " students:\n";
+  bool ok = check("indexed tree", tree, students);
+  ok = check("copy", copy, students) && ok;
+  ok = check("frozen copy", frozen, students) && ok;
+  if (!ok) {
+    cout << "FAILED: the read API allocated\n";
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,225 @@
+/**
+ * loadgen.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Load generator for GradeSystem --serve. Seeds a block of test students,
+ * then drives the server from several connections with pipelined batches
+ * of GET/UPDATE requests and reports throughput and latency percentiles.
+ * The test students are deleted again at the end.
+ *
+ * Usage: GradeLoadGen [address] [-c connections] [-d depth] [-n requests]
+ *                     [-r readPercent] [-s students]
+ */
+
+#include "QueryServer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+// Seeded students use IDs from here up, away from real records
+const int FIRST_TEST_ID = 900000000;
+
+struct Options {
+  string address = DEFAULT_SERVER_ADDRESS;
+  int connections = 4;
+  int depth = 32;         // Requests per pipelined batch
+  int requests = 100000;  // Requests per connection
+  int readPercent = 90;   // Remaining requests are grade updates
+  int students = 10000;
+};
+
+#if defined(__linux__)
+
+// Send a batch and wait for one response line per request.
+// Appends the latency of each response (in ns) to latencies if given.
+static bool roundTrip(int fd, const string &batch, int expected,
+                      vector<long long> *latencies) {
+  Clock::time_point sent = Clock::now();
+  size_t written = 0;
+  while (written < batch.size()) {
+    ssize_t n = write(fd, batch.data() + written, batch.size() - written);
+    if (n <= 0) {
+      return false;
+    }
+    written += static_cast<size_t>(n);
+  }
+
+  char buffer[64 * 1024];
+  int received = 0;
+  while (received < expected) {
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n <= 0) {
+      return false;
+    }
+    long long elapsed =
+        chrono::duration_cast<chrono::nanoseconds>(Clock::now() - sent)
+            .count();
+    for (ssize_t i = 0; i < n; ++i) {
+      if (buffer[i] == '\n') {
+        received++;
+        if (latencies != nullptr) {
+          latencies->push_back(elapsed);
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Run the same request line for every test student, depth at a time
+static bool forEachStudent(const Options &opt, const string &prefix,
+                           const string &suffix) {
+  int fd = connectToServer(opt.address);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = true;
+  for (int first = 0; ok && first < opt.students; first += opt.depth) {
+    string batch;
+    int count = min(opt.depth, opt.students - first);
+    for (int i = 0; i < count; ++i) {
+      batch += prefix + to_string(FIRST_TEST_ID + first + i) + suffix + "\n";
+    }
+    ok = roundTrip(fd, batch, count, nullptr);
+  }
+  close(fd);
+  return ok;
+}
+
+static void worker(const Options &opt, unsigned seed,
+                   vector<long long> &latencies, bool &failed) {
+  int fd = connectToServer(opt.address);
+  if (fd < 0) {
+    failed = true;
+    return;
+  }
+
+  mt19937 rng(seed);
+  latencies.reserve(opt.requests);
+  for (int done = 0; done < opt.requests; done += opt.depth) {
+    string batch;
+    int count = min(opt.depth, opt.requests - done);
+    for (int i = 0; i < count; ++i) {
+      string id = to_string(FIRST_TEST_ID + rng() % opt.students);
+      if (static_cast<int>(rng() % 100) < opt.readPercent) {
+        batch += "GET\t" + id + "\n";
+      } else {
+        batch += "UPDATE\t" + id + "\tLoad Test\t" + to_string(rng() % 101) +
+                 "\n";
+      }
+    }
+    if (!roundTrip(fd, batch, count, &latencies)) {
+      failed = true;
+      break;
+    }
+  }
+  close(fd);
+}
+
+static double percentile(const vector<long long> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+  return sorted[index] / 1000.0; // microseconds
+}
+
+int main(int argc, char *argv[]) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (i + 1 < argc && arg == "-c") {
+      opt.connections = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-d") {
+      opt.depth = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-n") {
+      opt.requests = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-r") {
+      opt.readPercent = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-s") {
+      opt.students = atoi(argv[++i]);
+    } else if (arg[0] != '-') {
+      opt.address = arg;
+    } else {
+      cout << "Usage: " << argv[0]
+           << " [address] [-c connections] [-d depth] [-n requests]"
+              " [-r readPercent] [-s students]\n";
+      return 1;
+    }
+  }
+  if (opt.connections < 1 || opt.depth < 1 || opt.requests < 1 ||
+      opt.students < 1) {
+    cout << "Error: counts must be positive.\n";
+    return 1;
+  }
+
+  cout << "Seeding " << opt.students << " test students on " << opt.address
+       << "...\n";
+  if (!forEachStudent(opt, "ADD\t", "\tLoad Test Student\tLoad Test\t75")) {
+    cout << "Error: could not reach server at " << opt.address << ".\n";
+    return 1;
+  }
+
+  vector<vector<long long>> latencies(opt.connections);
+  vector<char> failed(opt.connections, 0);
+  vector<thread> threads;
+
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < opt.connections; ++i) {
+    threads.emplace_back([&, i] {
+      bool f = false;
+      worker(opt, 12345u + i, latencies[i], f);
+      failed[i] = f;
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+  vector<long long> all;
+  for (const auto &l : latencies) {
+    all.insert(all.end(), l.begin(), l.end());
+  }
+  sort(all.begin(), all.end());
+
+  forEachStudent(opt, "DEL\t", "");
+
+  if (find(failed.begin(), failed.end(), 1) != failed.end()) {
+    cout << "Warning: some connections failed before finishing.\n";
+  }
+
+  cout << fixed << setprecision(1);
+  cout << "Requests:    " << all.size() << " over " << opt.connections
+       << " connections, pipeline depth " << opt.depth << "\n";
+  cout << "Throughput:  " << all.size() / seconds << " requests/s\n";
+  cout << "Latency (us, per pipelined batch round trip):\n";
+  cout << "  p50  " << percentile(all, 0.50) << "\n";
+  cout << "  p99  " << percentile(all, 0.99) << "\n";
+  cout << "  p999 " << percentile(all, 0.999) << "\n";
+  cout << "  max  " << percentile(all, 1.0) << "\n";
+  return 0;
+}
+
+#else
+
+int main() {
+  cout << "GradeLoadGen requires Linux." << endl;
+  return 1;
+}
+
+#endif
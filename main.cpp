@@ -13,9 +13,21 @@
  */
 
 #include "AVLTree.h"
+#include "BackgroundSave.h"
+#include "GradingScale.h"
+#include "Metrics.h"
+#include "QueryServer.h"
+#include "WorkloadTrace.h"
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
@@ -26,15 +38,128 @@ void searchStudent(AVLTree &tree);
 void updateGrade(AVLTree &tree);
 void deleteRecord(AVLTree &tree);
 void displayAll(AVLTree &tree);
-void saveData(AVLTree &tree);
-void loadData(AVLTree &tree);
+void saveData(AVLTree &tree, BackgroundSave &saver, bool exiting);
+void reportBackgroundSave(BackgroundSave &saver, bool waitForIt);
+void loadData(AVLTree &tree, bool lazy, int sortBudgetMB);
+void loadDefaultFile(AVLTree &tree, int sortBudgetMB);
+void manageSnapshots(AVLTree &tree);
+void printStudentRecord(const AVLNode *student);
+void searchByName(AVLTree &tree, bool approximate);
+void searchByCourses(AVLTree &tree);
+vector<string> readCourseList(const string &prompt);
 void clearInputBuffer();
+int runServer(const string &address, WorkloadRecorder &recorder,
+              const string &recordFile, int tierBudgetMB, int sortBudgetMB);
+bool enableTiering(AVLTree &tree, int budgetMB);
+void finishMetrics(bool printStats, const string &traceFile);
+void finishRecording(WorkloadRecorder &recorder, const AVLTree &tree,
+                     const string &recordFile);
+void printChanges(const vector<TraceRecord> &changes, size_t limit);
+int writeChangeFile(const string &baseFile, const string &changeFile,
+                    int sortBudgetMB);
+int applyChangeFile(const string &changeFile, int sortBudgetMB);
 
 // Default CSV filename
 const string DEFAULT_FILENAME = "student_grades.csv";
 
-int main() {
+// Page file of cold student records in tiered mode (see RecordPager.h)
+const string PAGE_FILENAME = "student_grades.pages";
+
+int main(int argc, char *argv[]) {
+  // GradeSystem [--serve [address]] [--lazy] [--tiered MB] [--external MB]
+  //             [--scale name|file] [--stats] [--trace file] [--record file]
+  //             [--diff base changes | --apply changes]
+  bool serve = false, lazyLoad = false, printStats = false;
+  int tierBudgetMB = 0, sortBudgetMB = 0;
+  string address = DEFAULT_SERVER_ADDRESS, scaleName, traceFile, recordFile;
+  string diffBase, changeFile, applyFile;
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (arg == "--serve") {
+      serve = true;
+      if (i + 1 < argc && argv[i + 1][0] != '-') {
+        address = argv[++i];
+      }
+    } else if (arg == "--lazy") {
+      lazyLoad = true; // Load the startup file on demand
+    } else if (arg == "--tiered" && i + 1 < argc && atoi(argv[i + 1]) > 0) {
+      tierBudgetMB = atoi(argv[++i]); // Keep this many MB of records
+    } else if (arg == "--external" && i + 1 < argc &&
+               atoi(argv[i + 1]) > 0) {
+      sortBudgetMB = atoi(argv[++i]); // Sort files on disk in this much memory
+    } else if (arg == "--scale" && i + 1 < argc) {
+      scaleName = argv[++i];
+    } else if (arg == "--stats") {
+      printStats = true;
+    } else if (arg == "--trace" && i + 1 < argc) {
+      traceFile = argv[++i];
+    } else if (arg == "--record" && i + 1 < argc) {
+      recordFile = argv[++i];
+    } else if (arg == "--diff" && i + 2 < argc) {
+      diffBase = argv[++i];   // Grade book the changes start from
+      changeFile = argv[++i]; // Change set to write
+    } else if (arg == "--apply" && i + 1 < argc) {
+      applyFile = argv[++i];
+    } else {
+      cout << "Usage: " << argv[0]
+           << " [--serve [address]] [--lazy] [--tiered MB]"
+              " [--external MB] [--scale name|file] [--stats]"
+              " [--trace file] [--record file]"
+              " [--diff base changes | --apply changes]\n";
+      return 1;
+    }
+  }
+  // Grading policy: a built-in scale ("standard", "plusminus") or a policy
+  // file (see GradingScale.h). Set before any grade is loaded.
+  if (!scaleName.empty()) {
+    GradingPolicy policy;
+    GradingScale scale;
+    string error;
+    if (GradingScale::builtIn(scaleName, scale)) {
+      policy.setDefaultScale(scale);
+    } else if (!policy.loadFromFile(scaleName, error)) {
+      cout << "Error: Invalid grading policy (" << error << ").\n";
+      return 1;
+    }
+    setGradingPolicy(policy);
+  }
+  if (!traceFile.empty()) {
+    Metrics::startTrace();
+  }
+
+  // Workload recording for GradeReplay (see WorkloadTrace.h)
+  WorkloadRecorder recorder;
+  if (!recordFile.empty() && !recorder.open(recordFile)) {
+    cout << "Error: Could not create workload trace '" << recordFile
+         << "'.\n";
+    return 1;
+  }
+
+  // Change set mode: compare or update the grade book, then exit
+  if (!changeFile.empty() || !applyFile.empty()) {
+    int status = !changeFile.empty()
+                     ? writeChangeFile(diffBase, changeFile, sortBudgetMB)
+                     : applyChangeFile(applyFile, sortBudgetMB);
+    finishMetrics(printStats, traceFile);
+    return status;
+  }
+
+  // Server mode: answer socket requests instead of showing the menu
+  if (serve) {
+    int status = runServer(address, recorder, recordFile, tierBudgetMB,
+                           sortBudgetMB);
+    finishMetrics(printStats, traceFile);
+    return status;
+  }
+
   AVLTree gradeTree;
+  if (recorder.isOpen()) {
+    gradeTree.setRecorder(&recorder);
+  }
+  if (tierBudgetMB > 0 && !enableTiering(gradeTree, tierBudgetMB)) {
+    return 1;
+  }
+  BackgroundSave backgroundSave; // Declared after the tree: finishes first
   int choice;
   bool running = true;
 
@@ -55,14 +180,15 @@ int main() {
   // Attempt to load existing data at startup
   cout << "\nAttempting to load existing data from '" << DEFAULT_FILENAME
        << "'...\n";
-  loadData(gradeTree);
+  loadData(gradeTree, lazyLoad, sortBudgetMB);
 
   while (running) {
+    reportBackgroundSave(backgroundSave, false);
     displayMenu();
-    cout << "\nEnter your choice (1-8): ";
+    cout << "\nEnter your choice (1-9): ";
 
     if (!(cin >> choice)) {
-      cout << "Invalid input! Please enter a number between 1 and 8.\n";
+      cout << "Invalid input! Please enter a number between 1 and 9.\n";
       clearInputBuffer();
       continue;
     }
@@ -86,12 +212,15 @@ int main() {
       displayAll(gradeTree);
       break;
     case 6:
-      saveData(gradeTree);
+      saveData(gradeTree, backgroundSave, false);
       break;
     case 7:
-      loadData(gradeTree);
+      loadData(gradeTree, false, sortBudgetMB);
       break;
     case 8:
+      manageSnapshots(gradeTree);
+      break;
+    case 9:
       cout << "\n========================================\n";
       cout << "Exiting Program\n";
       cout << "========================================\n";
@@ -102,21 +231,66 @@ int main() {
       clearInputBuffer();
 
       if (saveChoice == 'y' || saveChoice == 'Y') {
-        saveData(gradeTree);
+        saveData(gradeTree, backgroundSave, true);
       }
+      reportBackgroundSave(backgroundSave, true); // Finish before exiting
 
       cout << "\nThank you for using the Student Grade Monitoring System!\n";
       cout << "Goodbye!\n\n";
       running = false;
       break;
     default:
-      cout << "\nInvalid choice! Please select a number between 1 and 8.\n";
+      cout << "\nInvalid choice! Please select a number between 1 and 9.\n";
     }
   }
 
+  if (recorder.isOpen()) {
+    finishRecording(recorder, gradeTree, recordFile);
+  }
+  finishMetrics(printStats, traceFile);
   return 0;
 }
 
+// Close the workload trace with the final tree state
+void finishRecording(WorkloadRecorder &recorder, const AVLTree &tree,
+                     const string &recordFile) {
+  uint64_t operations = recorder.recordedOperations();
+  if (recorder.finish(tree)) {
+    cout << "Workload trace: " << operations << " operations recorded to '"
+         << recordFile << "'.\n";
+  } else {
+    cout << "Error: Could not write workload trace '" << recordFile
+         << "'.\n";
+  }
+}
+
+// Page cold student records out to PAGE_FILENAME
+bool enableTiering(AVLTree &tree, int budgetMB) {
+  if (!tree.enableTiering(PAGE_FILENAME, static_cast<size_t>(budgetMB)
+                                             << 20)) {
+    cout << "Error: Could not create page file '" << PAGE_FILENAME << "'.\n";
+    return false;
+  }
+  cout << "Tiered storage: up to " << budgetMB
+       << " MB of student records stay in memory, the rest are paged to '"
+       << PAGE_FILENAME << "'.\n";
+  return true;
+}
+
+// Print latency statistics and write the trace file if requested
+void finishMetrics(bool printStats, const string &traceFile) {
+  if (printStats) {
+    Metrics::dump(cout);
+  }
+  if (!traceFile.empty()) {
+    if (Metrics::writeTrace(traceFile)) {
+      cout << "Trace written to '" << traceFile << "'.\n";
+    } else {
+      cout << "Error: Could not write trace file '" << traceFile << "'.\n";
+    }
+  }
+}
+
 void displayMenu() {
   cout << "\n";
   cout << "========================================\n";
@@ -129,7 +303,8 @@ void displayMenu() {
   cout << "5. Display All Students\n";
   cout << "6. Save Data to File\n";
   cout << "7. Load Data from File\n";
-  cout << "8. Exit\n";
+  cout << "8. Semester Snapshots\n";
+  cout << "9. Exit\n";
   cout << "========================================\n";
 }
 
@@ -149,17 +324,16 @@ void addGrade(AVLTree &tree) {
   }
   clearInputBuffer();
 
-  // Check if student exists
-  AVLNode *existing = tree.search(studentID);
+  // Check if student exists (the handle is reused for the edit below)
+  StudentHandle student = tree.lookup(studentID);
 
-  if (existing != nullptr) {
+  if (student) {
     cout << "\n✓ Student ID " << studentID
-         << " already exists: " << existing->getName() << endl;
-    cout << "Current courses: " << existing->getCourseCount() << endl;
-    cout << "Current GPA: " << fixed << setprecision(2) << existing->getGPA()
+         << " already exists: " << student->getName() << endl;
+    cout << "Current courses: " << student->getCourseCount() << endl;
+    cout << "Current GPA: " << fixed << setprecision(2) << student->getGPA()
          << endl;
     cout << "\nAdding a new course for this student...\n\n";
-    name = existing->getName(); // Use existing name
   } else {
     cout << "Enter Student Name: ";
     getline(cin, name);
@@ -175,20 +349,19 @@ void addGrade(AVLTree &tree) {
   }
   clearInputBuffer();
 
-  // Insert (will add course if student exists, create new if doesn't)
-  tree.insert(studentID, name, course, grade);
-
-  if (existing == nullptr) {
+  if (student) {
+    bool added = student.addCourse(course, grade);
+    AVLTree::reportCourseAdded(student.get(), course, added);
+  } else {
+    student = tree.findOrCreate(studentID, std::move(name), std::move(course),
+                                grade);
     cout << "\n✓ New student record created successfully!\n";
   }
 
   // Show updated info
-  AVLNode *student = tree.search(studentID);
-  if (student != nullptr) {
-    cout << "Updated GPA: " << fixed << setprecision(2) << student->getGPA()
-         << endl;
-    cout << "Total courses: " << student->getCourseCount() << endl;
-  }
+  cout << "Updated GPA: " << fixed << setprecision(2) << student->getGPA()
+       << endl;
+  cout << "Total courses: " << student->getCourseCount() << endl;
 }
 
 void searchStudent(AVLTree &tree) {
@@ -196,6 +369,29 @@ void searchStudent(AVLTree &tree) {
   cout << "SEARCH STUDENT\n";
   cout << "========================================\n";
 
+  int mode;
+  cout << "Search by:\n";
+  cout << "  1. Student ID\n";
+  cout << "  2. Name (beginning of any name word)\n";
+  cout << "  3. Name (approximate spelling)\n";
+  cout << "  4. Courses taken (cohort)\n";
+  cout << "Enter choice (1-4): ";
+
+  while (!(cin >> mode) || mode < 1 || mode > 4) {
+    cout << "Invalid input! Please enter 1, 2, 3 or 4: ";
+    clearInputBuffer();
+  }
+  clearInputBuffer();
+
+  if (mode == 4) {
+    searchByCourses(tree);
+    return;
+  }
+  if (mode != 1) {
+    searchByName(tree, mode == 3);
+    return;
+  }
+
   int studentID;
   cout << "Enter Student ID to search: ";
 
@@ -208,42 +404,138 @@ void searchStudent(AVLTree &tree) {
   AVLNode *result = tree.search(studentID);
 
   if (result != nullptr) {
-    cout << "\n✓ Student Found!\n";
-    cout << string(70, '-') << endl;
-    cout << left << setw(20) << "Student ID:" << result->getStudentID() << endl
-         << setw(20) << "Name:" << result->getName() << endl
-         << setw(20) << "Overall GPA:" << fixed << setprecision(2)
-         << result->getGPA() << endl
-         << setw(20) << "Total Courses:" << result->getCourseCount() << endl;
-    cout << string(70, '-') << endl;
-
-    cout << "\nCourses:\n";
-    cout << left << setw(40) << "  Course Name" << setw(15) << "Grade"
-         << setw(15) << "Letter" << endl;
-    cout << "  " << string(65, '-') << endl;
-
-    for (const auto &course : result->getCourses()) {
-      string letter;
-      if (course.grade >= 90)
-        letter = "A";
-      else if (course.grade >= 80)
-        letter = "B";
-      else if (course.grade >= 70)
-        letter = "C";
-      else if (course.grade >= 60)
-        letter = "D";
-      else
-        letter = "F";
-
-      cout << "  " << left << setw(40) << course.courseName << setw(15) << fixed
-           << setprecision(2) << course.grade << setw(15) << letter << endl;
-    }
-    cout << string(70, '-') << endl;
+    printStudentRecord(result);
   } else {
     cout << "\n✗ Student with ID " << studentID << " not found.\n";
   }
 }
 
+// Name search: list the matches, or show the record of a single match
+void searchByName(AVLTree &tree, bool approximate) {
+  const size_t MAX_RESULTS = 20;
+  string name;
+  cout << "Enter name" << (approximate ? "" : " prefix") << ": ";
+  getline(cin, name);
+  if (name.empty()) {
+    cout << "\n✗ No name entered.\n";
+    return;
+  }
+
+  vector<StudentMatch> matches;
+  if (approximate) {
+    // Allow about one typo per four letters, at most 3
+    int maxDistance = min(3, static_cast<int>(name.size() + 3) / 4);
+    matches = tree.searchByNameFuzzy(name, maxDistance, MAX_RESULTS + 1);
+  } else {
+    matches = tree.searchByNamePrefix(name, MAX_RESULTS + 1);
+  }
+
+  if (matches.empty()) {
+    cout << "\n✗ No student names match '" << name << "'.\n";
+    return;
+  }
+  if (matches.size() == 1) {
+    printStudentRecord(matches[0].student);
+    return;
+  }
+
+  cout << "\n" << left << setw(15) << "Student ID" << setw(35) << "Name"
+       << setw(10) << "GPA" << "Courses\n";
+  cout << string(70, '-') << "\n";
+  for (size_t i = 0; i < matches.size() && i < MAX_RESULTS; ++i) {
+    const AVLNode *student = matches[i].student;
+    cout << left << setw(15) << student->getStudentID() << setw(35)
+         << student->getName() << setw(10) << fixed << setprecision(2)
+         << student->getGPA() << student->getCourseCount() << "\n";
+  }
+  if (matches.size() > MAX_RESULTS) {
+    cout << "(more than " << MAX_RESULTS
+         << " matches; type more of the name to narrow the list)\n";
+  }
+  cout << "\nSearch by Student ID to see a full record.\n";
+}
+
+// Cohort search: students who took all of some courses, at least one of
+// others and none of a third group
+void searchByCourses(AVLTree &tree) {
+  const size_t MAX_RESULTS = 20;
+  CohortQuery query;
+  query.allOf = readCourseList("Took all of");
+  query.anyOf = readCourseList("Took at least one of");
+  query.noneOf = readCourseList("Took none of");
+  if (query.allOf.empty() && query.anyOf.empty() && query.noneOf.empty()) {
+    cout << "\n✗ No courses entered.\n";
+    return;
+  }
+
+  vector<int> matches = tree.cohort(query);
+  if (matches.empty()) {
+    cout << "\n✗ No students match.\n";
+    return;
+  }
+
+  cout << "\n" << matches.size() << " student"
+       << (matches.size() == 1 ? "" : "s") << " match.\n\n";
+  cout << left << setw(15) << "Student ID" << setw(35) << "Name" << setw(10)
+       << "GPA" << "Courses\n";
+  cout << string(70, '-') << "\n";
+  for (size_t i = 0; i < matches.size() && i < MAX_RESULTS; ++i) {
+    const AVLNode *student = tree.find(matches[i]); // Not timed or recorded
+    cout << left << setw(15) << student->getStudentID() << setw(35)
+         << student->getName() << setw(10) << fixed << setprecision(2)
+         << student->getGPA() << student->getCourseCount() << "\n";
+  }
+  if (matches.size() > MAX_RESULTS) {
+    cout << "(first " << MAX_RESULTS << " shown)\n";
+  }
+}
+
+// Read a comma-separated list of course names (empty if Enter is pressed)
+vector<string> readCourseList(const string &prompt) {
+  cout << prompt << " (comma-separated, or Enter to skip): ";
+  string line;
+  getline(cin, line);
+
+  vector<string> courses;
+  stringstream ss(line);
+  string course;
+  while (getline(ss, course, ',')) {
+    size_t first = course.find_first_not_of(' ');
+    if (first != string::npos) {
+      courses.push_back(
+          course.substr(first, course.find_last_not_of(' ') - first + 1));
+    }
+  }
+  return courses;
+}
+
+// Print a student's header and course table
+void printStudentRecord(const AVLNode *result) {
+  cout << "\n✓ Student Found!\n";
+  cout << string(70, '-') << endl;
+  cout << left << setw(20) << "Student ID:" << result->getStudentID() << endl
+       << setw(20) << "Name:" << result->getName() << endl
+       << setw(20) << "Overall GPA:" << fixed << setprecision(2)
+       << result->getGPA() << endl
+       << setw(20) << "Total Courses:" << result->getCourseCount() << endl;
+  cout << string(70, '-') << endl;
+
+  cout << "\nCourses:\n";
+  cout << left << setw(40) << "  Course Name" << setw(15) << "Grade"
+       << setw(15) << "Letter" << endl;
+  cout << "  " << string(65, '-') << endl;
+
+  const GradingPolicy &policy = gradingPolicy();
+  for (const auto &course : result->getCourses()) {
+    const string &letter =
+        policy.letter(course.courseName.view(), course.grade);
+
+    cout << "  " << left << setw(40) << course.courseName << setw(15) << fixed
+         << setprecision(2) << course.grade << setw(15) << letter << endl;
+  }
+  cout << string(70, '-') << endl;
+}
+
 void updateGrade(AVLTree &tree) {
   cout << "\n========================================\n";
   cout << "UPDATE COURSE GRADE\n";
@@ -257,8 +549,8 @@ void updateGrade(AVLTree &tree) {
   }
   clearInputBuffer();
 
-  AVLNode *student = tree.search(studentID);
-  if (student == nullptr) {
+  StudentHandle student = tree.lookup(studentID);
+  if (!student) {
     cout << "\n✗ Student with ID " << studentID << " not found.\n";
     return;
   }
@@ -292,7 +584,8 @@ void updateGrade(AVLTree &tree) {
   }
   clearInputBuffer();
 
-  if (tree.updateCourse(studentID, courseName, newGrade)) {
+  if (student.updateCourse(courseName, newGrade)) {
+    // The handle follows the record if it was path-copied from a snapshot
     cout << "\n✓ Course grade updated successfully!\n";
     cout << "Updated GPA: " << fixed << setprecision(2) << student->getGPA()
          << endl;
@@ -315,8 +608,8 @@ void deleteRecord(AVLTree &tree) {
   }
   clearInputBuffer();
 
-  AVLNode *student = tree.search(studentID);
-  if (student == nullptr) {
+  StudentHandle student = tree.lookup(studentID);
+  if (!student) {
     cout << "\n✗ Student with ID " << studentID << " not found.\n";
     return;
   }
@@ -362,7 +655,7 @@ void deleteRecord(AVLTree &tree) {
     clearInputBuffer();
 
     if (confirm == 'y' || confirm == 'Y') {
-      if (tree.deleteCourse(studentID, courseName)) {
+      if (student.deleteCourse(courseName)) {
         cout << "\n✓ Course deleted successfully!\n";
         cout << "Updated GPA: " << fixed << setprecision(2) << student->getGPA()
              << endl;
@@ -394,11 +687,22 @@ void deleteRecord(AVLTree &tree) {
 
 void displayAll(AVLTree &tree) { tree.display(); }
 
-void saveData(AVLTree &tree) {
+// Start a background save; the menu stays usable while it runs
+// When exiting, a save still running is waited for instead of refused, so
+// the edits made since it started are saved too
+void saveData(AVLTree &tree, BackgroundSave &saver, bool exiting) {
   cout << "\n========================================\n";
   cout << "SAVE DATA TO FILE\n";
   cout << "========================================\n";
 
+  reportBackgroundSave(saver, exiting);
+  if (saver.isRunning()) {
+    cout << "A save to '" << saver.filename() << "' is still running ("
+         << saver.written() << "/" << saver.total()
+         << " students written). Please try again when it finishes.\n";
+    return;
+  }
+
   string filename;
   cout << "Enter filename (or press Enter for default '" << DEFAULT_FILENAME
        << "'): ";
@@ -408,10 +712,37 @@ void saveData(AVLTree &tree) {
     filename = DEFAULT_FILENAME;
   }
 
-  tree.saveToFile(filename);
+  saver.start(tree, filename);
+  if (saver.isRunning()) {
+    cout << "Saving " << saver.total() << " students to '" << filename
+         << "' in the background...\n";
+  } else {
+    reportBackgroundSave(saver, false); // Tiered trees save in the foreground
+  }
 }
 
-void loadData(AVLTree &tree) {
+// Print the outcome of a finished background save (optionally waiting for a
+// running one, showing its progress)
+void reportBackgroundSave(BackgroundSave &saver, bool waitForIt) {
+  if (waitForIt) {
+    while (saver.isRunning()) {
+      cout << "\rSaving to '" << saver.filename() << "': " << saver.written()
+           << "/" << saver.total() << " students" << flush;
+      this_thread::sleep_for(chrono::milliseconds(100));
+    }
+  }
+
+  BackgroundSave::Status status = saver.collect();
+  if (status == BackgroundSave::SUCCEEDED) {
+    cout << "\n✓ Background save complete: " << saver.total()
+         << " students saved to '" << saver.filename() << "'.\n";
+  } else if (status == BackgroundSave::FAILED) {
+    cout << "\n✗ Background save to '" << saver.filename()
+         << "' failed; the previous file was left unchanged.\n";
+  }
+}
+
+void loadData(AVLTree &tree, bool lazy, int sortBudgetMB) {
   cout << "\n========================================\n";
   cout << "LOAD DATA FROM FILE\n";
   cout << "========================================\n";
@@ -425,10 +756,253 @@ void loadData(AVLTree &tree) {
     filename = DEFAULT_FILENAME;
   }
 
-  tree.loadFromFile(filename);
+  if (lazy) {
+    tree.loadLazily(filename);
+  } else if (sortBudgetMB > 0) {
+    tree.loadExternal(filename, static_cast<size_t>(sortBudgetMB) << 20);
+  } else {
+    tree.loadFromFile(filename);
+  }
+}
+
+// Load DEFAULT_FILENAME without asking (server and change set modes)
+void loadDefaultFile(AVLTree &tree, int sortBudgetMB) {
+  if (sortBudgetMB > 0) {
+    tree.loadExternal(DEFAULT_FILENAME, static_cast<size_t>(sortBudgetMB)
+                                            << 20);
+  } else {
+    tree.loadFromFile(DEFAULT_FILENAME);
+  }
+}
+
+void manageSnapshots(AVLTree &tree) {
+  cout << "\n========================================\n";
+  cout << "SEMESTER SNAPSHOTS\n";
+  cout << "========================================\n";
+
+  vector<string> labels = tree.versionLabels();
+  if (labels.empty()) {
+    cout << "No snapshots saved yet.\n";
+  } else {
+    cout << "Saved snapshots:\n";
+    for (const auto &label : labels) {
+      cout << "  - " << label << endl;
+    }
+  }
+
+  cout << "\n1. Save current grades as a snapshot\n";
+  cout << "2. Search student in a snapshot\n";
+  cout << "3. Display all students in a snapshot\n";
+  cout << "4. Delete a snapshot\n";
+  cout << "5. Show changes since a snapshot\n";
+  cout << "Enter choice (1-5): ";
+
+  int choice;
+  if (!(cin >> choice)) {
+    cout << "Invalid input!\n";
+    clearInputBuffer();
+    return;
+  }
+  clearInputBuffer();
+
+  string label;
+  cout << "Enter snapshot label (e.g. Spring 2025): ";
+  getline(cin, label);
+
+  if (choice == 1) {
+    tree.saveVersion(label);
+    cout << "\n✓ Snapshot '" << label << "' saved.\n";
+    return;
+  }
+
+  if (!tree.hasVersion(label)) {
+    cout << "\n✗ Snapshot '" << label << "' not found.\n";
+    return;
+  }
+
+  if (choice == 2) {
+    int studentID;
+    cout << "Enter Student ID to search: ";
+    while (!(cin >> studentID) || studentID <= 0) {
+      cout << "Invalid input! Please enter a positive integer: ";
+      clearInputBuffer();
+    }
+    clearInputBuffer();
+
+    AVLTree snapshot = tree.getVersion(label);
+    AVLNode *result = snapshot.search(studentID);
+    if (result != nullptr) {
+      cout << "\nAs of '" << label << "':";
+      printStudentRecord(result);
+    } else {
+      cout << "\n✗ Student with ID " << studentID << " not found in '"
+           << label << "'.\n";
+    }
+  } else if (choice == 3) {
+    tree.getVersion(label).display();
+  } else if (choice == 4) {
+    tree.dropVersion(label);
+    cout << "\n✓ Snapshot '" << label << "' deleted.\n";
+  } else if (choice == 5) {
+    cout << "\nChanges since '" << label << "':";
+    printChanges(tree.diff(tree.getVersion(label)), 20);
+  } else {
+    cout << "\nInvalid choice!\n";
+  }
 }
 
 void clearInputBuffer() {
   cin.clear();
   cin.ignore(numeric_limits<streamsize>::max(), '\n');
 }
+
+// ==================== CHANGE SETS ====================
+
+// Count a change set by kind and list up to limit changes
+void printChanges(const vector<TraceRecord> &changes, size_t limit) {
+  if (changes.empty()) {
+    cout << " none.\n";
+    return;
+  }
+  size_t counts[TraceRecord::KIND_COUNT] = {};
+  for (const auto &change : changes) {
+    counts[change.kind]++;
+  }
+  cout << "\n";
+  for (int kind = 1; kind < TraceRecord::KIND_COUNT; ++kind) {
+    if (counts[kind] > 0) {
+      cout << "  " << setw(15) << left
+           << traceKindName(static_cast<TraceRecord::Kind>(kind)) << right
+           << counts[kind] << "\n";
+    }
+  }
+  cout << string(70, '-') << "\n";
+  for (size_t i = 0; i < changes.size() && i < limit; ++i) {
+    const TraceRecord &change = changes[i];
+    cout << "  " << setw(15) << left << traceKindName(change.kind) << right
+         << change.studentID;
+    if (!change.name.empty()) {
+      cout << "  " << change.name;
+    }
+    if (!change.course.empty()) {
+      cout << "  " << change.course;
+      if (change.kind != TraceRecord::DELETE_COURSE) {
+        cout << " (" << fixed << setprecision(2) << change.grade << ")";
+      }
+    }
+    cout << "\n";
+  }
+  if (changes.size() > limit) {
+    cout << "  ... and " << changes.size() - limit << " more\n";
+  }
+}
+
+// Write the changes that turn baseFile (e.g. last night's export) into the
+// grade book to changeFile, for --apply on another copy of baseFile
+int writeChangeFile(const string &baseFile, const string &changeFile,
+                    int sortBudgetMB) {
+  AVLTree tree, base;
+  loadDefaultFile(tree, sortBudgetMB);
+  if (!base.loadFromFile(baseFile)) {
+    // An empty base would turn the whole grade book into changes
+    cout << "Error: Could not load the base grade book '" << baseFile
+         << "'. No change set was written.\n";
+    return 1;
+  }
+  vector<TraceRecord> changes = tree.diff(base);
+  cout << "Changes from '" << baseFile << "' to '" << DEFAULT_FILENAME
+       << "':";
+  printChanges(changes, 20);
+  if (!writeChangeSet(changeFile, changes, tree)) {
+    cout << "Error: Could not write change set '" << changeFile << "'.\n";
+    return 1;
+  }
+  cout << "✓ " << changes.size() << " changes written to '" << changeFile
+       << "' (content hash " << hex << setw(16) << setfill('0')
+       << tree.contentHash() << dec << setfill(' ') << ").\n";
+  return 0;
+}
+
+// Apply a change set written by --diff to the grade book and save it
+int applyChangeFile(const string &changeFile, int sortBudgetMB) {
+  vector<TraceRecord> changes;
+  bool hasFinalState;
+  TreeFingerprint expected;
+  string error;
+  if (!readWorkloadTrace(changeFile, changes, hasFinalState, expected,
+                         error)) {
+    cout << "Error: Could not read change set '" << changeFile << "' ("
+         << error << ").\n";
+    return 1;
+  }
+
+  if (!hasFinalState || !expected.changeSet) {
+    cout << "Error: '" << changeFile << "' is not a complete change set "
+         << "(write one with --diff). Nothing was saved.\n";
+    return 1;
+  }
+
+  AVLTree tree;
+  loadDefaultFile(tree, sortBudgetMB);
+  tree.applyChanges(changes);
+  TreeFingerprint result = fingerprintTree(tree);
+  if (tree.contentHash() != expected.hash) {
+    cout << "Error: After the changes the grade book has " << result.students
+         << " students and " << result.courses << " courses (content hash "
+         << hex << setw(16) << setfill('0') << tree.contentHash()
+         << "), expected " << dec << expected.students << " and "
+         << expected.courses << " (content hash " << hex << setw(16)
+         << expected.hash << dec << setfill(' ')
+         << "). Was it loaded from a different base? Nothing was saved.\n";
+    return 1;
+  }
+  cout << "✓ " << changes.size() << " changes applied (content hash " << hex
+       << setw(16) << setfill('0') << tree.contentHash() << dec
+       << setfill(' ') << ").\n";
+  tree.saveToFile(DEFAULT_FILENAME);
+  return 0;
+}
+
+// ==================== SERVER MODE ====================
+
+static QueryServer *activeServer = nullptr;
+
+static void stopServer(int) {
+  if (activeServer != nullptr) {
+    activeServer->stop();
+  }
+}
+
+// Keep the tree resident and serve socket requests until interrupted
+int runServer(const string &address, WorkloadRecorder &recorder,
+              const string &recordFile, int tierBudgetMB, int sortBudgetMB) {
+  AVLTree tree;
+  if (recorder.isOpen()) {
+    tree.setRecorder(&recorder);
+  }
+  if (tierBudgetMB > 0 && !enableTiering(tree, tierBudgetMB)) {
+    return 1;
+  }
+  loadDefaultFile(tree, sortBudgetMB);
+
+  QueryServer server(tree);
+  if (!server.listen(address)) {
+    return 1;
+  }
+
+  activeServer = &server;
+  signal(SIGINT, stopServer);
+  signal(SIGTERM, stopServer);
+
+  cout << "Serving " << tree.size() << " students on " << address
+       << " (Ctrl+C to stop)\n";
+  server.run();
+
+  activeServer = nullptr;
+  cout << "\nServer stopped after " << server.requestsServed()
+       << " requests.\n";
+  if (recorder.isOpen()) {
+    finishRecording(recorder, tree, recordFile);
+  }
+  return 0;
+}
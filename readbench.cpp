@@ -0,0 +1,187 @@
+/**
+ * readbench.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Read scaling benchmark and stress test for ConcurrentTree. One writer
+ * thread re-grades, deletes and re-adds students and publishes after every
+ * change while 1, 2, 4, ... reader threads look students up without locks.
+ * Every student always has three courses with equal grades, so a reader
+ * that sees a torn or freed record (or a missing student) reports a
+ * failure. Prints read and write throughput per reader count and exits
+ * with status 1 if any read failed.
+ *
+ * Usage: GradeReadBench [-s students] [-t maxReaders] [-d secondsPerRun]
+ */
+
+#include "ConcurrentTree.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const int COURSES = 3;
+const char *const COURSE_NAMES[COURSES] = {"Course0", "Course1", "Course2"};
+
+struct Options {
+  int students = 100000;
+  int maxReaders = max(4, static_cast<int>(thread::hardware_concurrency()));
+  double seconds = 1.0;
+};
+
+static void addStudent(AVLTree &tree, int id, float grade) {
+  for (const char *course : COURSE_NAMES) {
+    tree.insert(id, "Student " + to_string(id), course, grade);
+  }
+}
+
+// A record as the writer leaves it between publishes
+static bool consistent(const AVLNode *student, int id) {
+  if (student == nullptr || student->getStudentID() != id ||
+      student->getCourseCount() != COURSES) {
+    return false;
+  }
+  float grade = student->getCourses().begin()->grade;
+  for (const auto &course : student->getCourses()) {
+    if (course.grade != grade) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct RunResult {
+  uint64_t reads;
+  uint64_t writes;
+  uint64_t failures;
+};
+
+static RunResult run(ConcurrentTree &tree, int students, int readers,
+                     double seconds) {
+  atomic<bool> stop{false};
+  atomic<uint64_t> reads{0}, failures{0};
+  uint64_t writes = 0;
+
+  thread writer([&] {
+    mt19937 rng(7);
+    while (!stop.load(memory_order_relaxed)) {
+      int id = 1 + static_cast<int>(rng() % students);
+      float grade = static_cast<float>(rng() % 101);
+      tree.write([&](AVLTree &t) {
+        if (rng() % 10 == 0) {
+          t.deleteStudent(id); // Re-added before the next publish
+          addStudent(t, id, grade);
+        } else {
+          for (const char *course : COURSE_NAMES) {
+            t.updateCourse(id, course, grade);
+          }
+        }
+      });
+      writes++;
+    }
+  });
+
+  vector<thread> threads;
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&, r] {
+      ConcurrentTree::Reader reader(tree);
+      mt19937 rng(100 + r);
+      uint64_t done = 0, failed = 0;
+      while (!stop.load(memory_order_relaxed)) {
+        for (int i = 0; i < 256; ++i) {
+          int id = 1 + static_cast<int>(rng() % students);
+          bool ok = reader.read([&](const AVLTree &snapshot) {
+            // Every 64th read also checks the snapshot's shape
+            if ((done & 63) == 0 && (snapshot.size() != students ||
+                                     snapshot.rank(id) != id - 1)) {
+              return false;
+            }
+            return consistent(snapshot.find(id), id);
+          });
+          failed += ok ? 0 : 1;
+          done++;
+        }
+      }
+      reads += done;
+      failures += failed;
+    });
+  }
+
+  this_thread::sleep_for(chrono::duration<double>(seconds));
+  stop = true;
+  writer.join();
+  for (thread &t : threads) {
+    t.join();
+  }
+  return {reads.load(), writes, failures.load()};
+}
+
+int main(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (i + 1 < argc && arg == "-s") {
+      options.students = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-t") {
+      options.maxReaders = atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "-d") {
+      options.seconds = atof(argv[++i]);
+    } else {
+      options.students = 0;
+      break;
+    }
+  }
+  if (options.students < 1 || options.maxReaders < 1 ||
+      options.seconds <= 0) {
+    cout << "Usage: " << argv[0]
+         << " [-s students] [-t maxReaders] [-d secondsPerRun]\n";
+    return 1;
+  }
+
+  ConcurrentTree tree(options.maxReaders);
+  // The tree prints a note for every course added; keep them quiet
+  streambuf *console = cout.rdbuf(nullptr);
+  tree.write([&](AVLTree &t) {
+    for (int id = 1; id <= options.students; ++id) {
+      addStudent(t, id, 75);
+    }
+  });
+  cout.rdbuf(console);
+  cout.clear();
+
+  cout << "Seeded " << options.students << " students; "
+       << thread::hardware_concurrency() << " hardware threads\n";
+  cout << right << setw(8) << "Readers" << setw(14) << "Reads/s"
+       << setw(14) << "Per reader" << setw(12) << "Writes/s" << setw(10)
+       << "Failures" << "\n";
+
+  uint64_t totalFailures = 0;
+  for (int readers = 1; readers <= options.maxReaders; readers *= 2) {
+    console = cout.rdbuf(nullptr);
+    RunResult result = run(tree, options.students, readers, options.seconds);
+    cout.rdbuf(console);
+    cout.clear();
+
+    double readRate = result.reads / options.seconds;
+    cout << fixed << setprecision(0) << setw(8) << readers << setw(14)
+         << readRate << setw(14) << readRate / readers << setw(12)
+         << result.writes / options.seconds << setw(10) << result.failures
+         << "\n";
+    totalFailures += result.failures;
+  }
+
+  if (totalFailures > 0) {
+    cout << "FAILED: " << totalFailures << " reads saw an inconsistent "
+         << "snapshot\n";
+    return 1;
+  }
+  return 0;
+}
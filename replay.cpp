@@ -0,0 +1,133 @@
+/**
+ * replay.cpp
+ * Student Grade Monitoring System - PS5
+ * CSC 307 Data Structures and Algorithm Analysis, Fall 2025
+ *
+ * Replays a workload trace recorded with GradeSystem --record against an
+ * empty tree at full speed, reports throughput and per-operation latency,
+ * and checks that the final tree matches the recorded run. Change sets
+ * (GradeSystem --diff) replay too, but apply to the grade book they were
+ * made from, so their final state is not checked.
+ *
+ * Usage: GradeReplay <trace file> [-r repeats]
+ */
+
+#include "AVLTree.h"
+#include "WorkloadTrace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static double percentile(const vector<long long> &sorted, double p) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+  return sorted[index] / 1000.0; // microseconds
+}
+
+int main(int argc, char *argv[]) {
+  string filename;
+  int repeats = 1;
+  for (int i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (i + 1 < argc && arg == "-r") {
+      repeats = atoi(argv[++i]);
+    } else if (arg[0] != '-' && filename.empty()) {
+      filename = arg;
+    } else {
+      filename.clear();
+      break;
+    }
+  }
+  if (filename.empty() || repeats < 1) {
+    cout << "Usage: " << argv[0] << " <trace file> [-r repeats]\n";
+    return 1;
+  }
+
+  vector<TraceRecord> records;
+  bool hasFinalState;
+  TreeFingerprint recorded;
+  string error;
+  if (!readWorkloadTrace(filename, records, hasFinalState, recorded, error)) {
+    cout << "Error: " << error << ".\n";
+    return 1;
+  }
+  cout << "Replaying " << records.size() << " operations from '" << filename
+       << "'" << (repeats > 1 ? " " + to_string(repeats) + " times" : "")
+       << "...\n";
+
+  vector<vector<long long>> latencies(TraceRecord::KIND_COUNT);
+  double seconds = 0;
+  bool matched = true;
+  TreeFingerprint replayed = {0, 0, 0, false};
+
+  for (int run = 0; run < repeats; ++run) {
+    AVLTree tree;
+
+    // The tree prints notes for some operations; keep them out of the timing
+    streambuf *console = cout.rdbuf(nullptr);
+    Clock::time_point start = Clock::now();
+    for (const TraceRecord &record : records) {
+      Clock::time_point before = Clock::now();
+      replayRecord(tree, record);
+      latencies[record.kind].push_back(
+          chrono::duration_cast<chrono::nanoseconds>(Clock::now() - before)
+              .count());
+    }
+    seconds += chrono::duration<double>(Clock::now() - start).count();
+    cout.rdbuf(console);
+    cout.clear();
+
+    replayed = fingerprintTree(tree);
+    matched = matched && (!hasFinalState || replayed == recorded);
+  }
+
+  uint64_t total = static_cast<uint64_t>(records.size()) * repeats;
+  cout << fixed << setprecision(2);
+  cout << "Throughput:  " << total / seconds << " operations/s ("
+       << seconds << " s)\n";
+  cout << "Latency (us):\n";
+  cout << "  " << left << setw(15) << "Operation" << right << setw(10)
+       << "Count" << setw(10) << "p50" << setw(10) << "p99" << setw(10)
+       << "p999" << setw(12) << "Max" << "\n";
+  for (int kind = 0; kind < TraceRecord::KIND_COUNT; ++kind) {
+    vector<long long> &l = latencies[kind];
+    if (l.empty()) {
+      continue;
+    }
+    sort(l.begin(), l.end());
+    cout << "  " << left << setw(15)
+         << traceKindName(static_cast<TraceRecord::Kind>(kind)) << right
+         << setw(10) << l.size() << setw(10) << percentile(l, 0.50)
+         << setw(10) << percentile(l, 0.99) << setw(10)
+         << percentile(l, 0.999) << setw(12) << percentile(l, 1.0) << "\n";
+  }
+
+  if (!hasFinalState) {
+    cout << "Final state: not checked (trace has no end record; the "
+            "recording was interrupted)\n";
+    return 0;
+  }
+  if (recorded.changeSet) {
+    cout << "Final state: not checked (a change set applies to the grade "
+            "book it was made from, not to an empty tree)\n";
+    return 0;
+  }
+  cout << "Final state: " << replayed.students << " students, "
+       << replayed.courses << " courses - "
+       << (matched ? "matches the recorded run" : "DOES NOT MATCH") << "\n";
+  if (!matched) {
+    cout << "  recorded: " << recorded.students << " students, "
+         << recorded.courses << " courses\n";
+    return 2;
+  }
+  return 0;
+}